@@ -76,6 +76,7 @@ typedef enum spv_result_t {
   SPV_ERROR_INVALID_ID = -10,
   SPV_ERROR_INVALID_CFG = -11,
   SPV_ERROR_INVALID_LAYOUT = -12,
+  SPV_ERROR_BUFFER_TOO_SMALL = -13,
   SPV_FORCE_32_BIT_ENUM(spv_result_t)
 } spv_result_t;
 
@@ -260,6 +261,9 @@ typedef enum spv_validate_options_t {
   SPV_VALIDATE_ID_BIT = SPV_BIT(2),
   SPV_VALIDATE_RULES_BIT = SPV_BIT(3),
   SPV_VALIDATE_SSA_BIT = SPV_BIT(4),
+  // Not a check: performs the ID checks of different functions on several
+  // threads.  The result and diagnostic are the same as without it.
+  SPV_VALIDATE_PARALLEL_BIT = SPV_BIT(5),
   SPV_VALIDATE_ALL = SPV_VALIDATE_BASIC_BIT | SPV_VALIDATE_LAYOUT_BIT |
                      SPV_VALIDATE_ID_BIT | SPV_VALIDATE_RULES_BIT |
                      SPV_VALIDATE_SSA_BIT,
@@ -348,7 +352,9 @@ typedef spv_context_t* spv_context;
 
 // Platform API
 
-// Creates a context object.
+// Creates a context object.  The grammar tables referenced by a context are
+// built once per process and shared, so creating a context is cheap.
+// This function is thread safe.
 spv_context spvContextCreate();
 
 // Destroys the given context object.
@@ -361,6 +367,20 @@ spv_result_t spvTextToBinary(const spv_const_context context, const char* text,
                              const size_t length, spv_binary* binary,
                              spv_diagnostic* diagnostic);
 
+// Encodes the given SPIR-V assembly text like spvTextToBinary, but writes the
+// words of the binary into the caller's buffer, which has room for capacity
+// words, instead of allocating a spv_binary.  On success, or if the buffer is
+// too small, the number of words in the binary is written to *word_count.
+// If that is more than capacity, then SPV_ERROR_BUFFER_TOO_SMALL is returned,
+// the contents of the buffer are unspecified, and the call may be repeated
+// with a buffer of at least *word_count words.  The binary parameter may be
+// null if capacity is 0.  Any error will be written into *diagnostic.
+spv_result_t spvTextToBinaryBuffer(const spv_const_context context,
+                                   const char* text, const size_t length,
+                                   uint32_t* binary, const size_t capacity,
+                                   size_t* word_count,
+                                   spv_diagnostic* diagnostic);
+
 // Frees an allocated text stream. This is a no-op if the text parameter
 // is a null pointer.
 void spvTextDestroy(spv_text text);
@@ -374,6 +394,46 @@ spv_result_t spvBinaryToText(const spv_const_context context,
                              const uint32_t options, spv_text* text,
                              spv_diagnostic* diagnostic);
 
+// A pointer to a function that accepts a chunk of disassembled text.
+// The text is not null-terminated, and is only valid until the function
+// returns.  The function should return SPV_SUCCESS if disassembly should
+// continue.
+typedef spv_result_t (*spv_text_write_fn_t)(void* user_data, const char* text,
+                                            size_t length);
+
+// Decodes the given SPIR-V binary representation to its assembly text, like
+// spvBinaryToText, but passes the text to the write_fn callback in chunks of
+// bounded size as the binary is decoded, instead of accumulating it.  The
+// user_data parameter is supplied as context to the callback.  The
+// SPV_BINARY_TO_TEXT_OPTION_PRINT and SPV_BINARY_TO_TEXT_OPTION_COLOR options
+// are ignored.  If the callback returns anything other than SPV_SUCCESS, then
+// that status code is returned and the callback is not called again.  On
+// failure the callback may already have received a prefix of the text.
+spv_result_t spvBinaryToTextStream(const spv_const_context context,
+                                   const uint32_t* binary,
+                                   const size_t word_count,
+                                   const uint32_t options, void* user_data,
+                                   spv_text_write_fn_t write_fn,
+                                   spv_diagnostic* diagnostic);
+
+// Decodes the given SPIR-V binary representation to its assembly text like
+// spvBinaryToText, but writes the text, followed by a null terminator, into
+// the caller's buffer, which has room for capacity characters, instead of
+// allocating a spv_text.  The SPV_BINARY_TO_TEXT_OPTION_PRINT and
+// SPV_BINARY_TO_TEXT_OPTION_COLOR options are ignored.  On success, or if the
+// buffer is too small, the length of the text, not counting the terminator,
+// is written to *length.  If the text and its terminator do not fit, then
+// SPV_ERROR_BUFFER_TOO_SMALL is returned, the contents of the buffer are
+// unspecified, and the call may be repeated with a buffer of at least
+// *length + 1 characters.  The text parameter may be null if capacity is 0.
+// Any error will be written into *diagnostic.
+spv_result_t spvBinaryToTextBuffer(const spv_const_context context,
+                                   const uint32_t* binary,
+                                   const size_t word_count,
+                                   const uint32_t options, char* text,
+                                   const size_t capacity, size_t* length,
+                                   spv_diagnostic* diagnostic);
+
 // Frees a binary stream from memory. This is a no-op if binary is a null
 // pointer.
 void spvBinaryDestroy(spv_binary binary);
@@ -384,6 +444,19 @@ spv_result_t spvValidate(const spv_const_context context,
                          const spv_const_binary binary, const uint32_t options,
                          spv_diagnostic* pDiagnostic);
 
+// Validates each of the count SPIR-V binaries in binaries as spvValidate
+// does, on up to threadCount threads, or on one thread per hardware thread if
+// threadCount is 0.  The result for binaries[i] is written to results[i], and
+// on failure its diagnostic is written to diagnostics[i].  Returns the result
+// of the first binary in the array which is invalid, or SPV_SUCCESS if all
+// are valid.
+spv_result_t spvValidateBatch(const spv_const_context context,
+                              const spv_const_binary* binaries,
+                              const size_t count, const uint32_t options,
+                              const uint32_t threadCount,
+                              spv_result_t* results,
+                              spv_diagnostic* diagnostics);
+
 // Creates a diagnostic object. The position parameter specifies the location in
 // the text/binary stream. The message parameter, copied into the diagnostic
 // object, contains the error message to display.
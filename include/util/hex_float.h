@@ -804,7 +804,12 @@ std::istream& operator>>(std::istream& is, HexFloat<T, Traits>& value) {
         if (bits_written) {
           // If we are here the bits represented belong in the fractional
           // part of the float, and we have to adjust the exponent accordingly.
-          fraction |= write_bit << (HF::top_bit_left_shift - fraction_index++);
+          // Bits beyond the width of the fraction are dropped.
+          if (fraction_index <= HF::top_bit_left_shift) {
+            fraction |= static_cast<uint_type>(
+                write_bit << (HF::top_bit_left_shift - fraction_index));
+          }
+          ++fraction_index;
           exponent += 1;
         }
         bits_written |= write_bit != 0;
@@ -832,8 +837,12 @@ std::istream& operator>>(std::istream& is, HexFloat<T, Traits>& value) {
           // an arbitrary number of hex values without overflowing our
           // integer.
           exponent -= 1;
+        } else if (fraction_index <= HF::top_bit_left_shift) {
+          fraction |= static_cast<uint_type>(
+              write_bit << (HF::top_bit_left_shift - fraction_index++));
         } else {
-          fraction |= write_bit << (HF::top_bit_left_shift - fraction_index++);
+          // Bits beyond the width of the fraction are dropped.
+          ++fraction_index;
         }
       }
     } else {
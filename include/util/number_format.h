@@ -0,0 +1,122 @@
+// Copyright (c) 2016 The Khronos Group Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and/or associated documentation files (the
+// "Materials"), to deal in the Materials without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Materials, and to
+// permit persons to whom the Materials are furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Materials.
+//
+// MODIFICATIONS TO THIS FILE MAY MEAN IT NO LONGER ACCURATELY REFLECTS
+// KHRONOS STANDARDS. THE UNMODIFIED, NORMATIVE VERSIONS OF KHRONOS
+// SPECIFICATIONS AND HEADER INFORMATION ARE LOCATED AT
+//    https://www.khronos.org/registry/
+//
+// THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+
+// Locale-independent formatting of numbers into caller-provided character
+// buffers.  The output is the same as writing the number to a std::ostream
+// imbued with the classic locale, but without the stream machinery.
+
+#ifndef LIBSPIRV_UTIL_NUMBER_FORMAT_H_
+#define LIBSPIRV_UTIL_NUMBER_FORMAT_H_
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+
+namespace spvutils {
+
+// The size of a buffer large enough to hold any number formatted by the
+// functions below.
+enum { kNumberFormatBufferSize = 32 };
+
+// Writes the decimal digits of value to buffer, and returns a pointer one
+// past the last character written.  The buffer is not null-terminated.
+inline char* FormatUnsigned(uint64_t value, char* buffer) {
+  static const char kDigitPairs[] =
+      "0001020304050607080910111213141516171819"
+      "2021222324252627282930313233343536373839"
+      "4041424344454647484950515253545556575859"
+      "6061626364656667686970717273747576777879"
+      "8081828384858687888990919293949596979899";
+  // Generate the digits backwards into a scratch area, two at a time.
+  char scratch[20];
+  char* p = scratch + sizeof(scratch);
+  while (value >= 100) {
+    const unsigned pair = unsigned(value % 100) * 2;
+    value /= 100;
+    *--p = kDigitPairs[pair + 1];
+    *--p = kDigitPairs[pair];
+  }
+  if (value >= 10) {
+    const unsigned pair = unsigned(value) * 2;
+    *--p = kDigitPairs[pair + 1];
+    *--p = kDigitPairs[pair];
+  } else {
+    *--p = char('0' + value);
+  }
+  const char* const end = scratch + sizeof(scratch);
+  while (p != end) *buffer++ = *p++;
+  return buffer;
+}
+
+// Like FormatUnsigned, but for a signed value.
+inline char* FormatSigned(int64_t value, char* buffer) {
+  if (value < 0) {
+    *buffer++ = '-';
+    // Negate in unsigned arithmetic so the most negative value works.
+    return FormatUnsigned(uint64_t(0) - uint64_t(value), buffer);
+  }
+  return FormatUnsigned(uint64_t(value), buffer);
+}
+
+// Writes value to buffer as std::ostream would with a precision of
+// std::numeric_limits<T>::digits10 and the default float field, i.e. like
+// printf("%.*g"), and returns a pointer one past the last character written.
+// The buffer is not null-terminated.  The value must be finite.
+template <typename T>
+char* FormatDecimalFloat(T value, char* buffer) {
+  const int precision = std::numeric_limits<T>::digits10;
+  // Integral values that fit in the precision are printed without an
+  // exponent or decimal point, so they can be written directly.  This is
+  // the common case for constants in shaders.
+  const double magnitude = std::fabs(double(value));
+  static const double kIntegralLimit = std::pow(10.0, precision);
+  if (magnitude < kIntegralLimit && magnitude == std::floor(magnitude)) {
+    if (std::signbit(value)) *buffer++ = '-';
+    return FormatUnsigned(uint64_t(magnitude), buffer);
+  }
+  char formatted[kNumberFormatBufferSize];
+  const int length = std::snprintf(formatted, sizeof(formatted), "%.*g",
+                                   precision, double(value));
+  // The C library uses the decimal point of the current C locale, which
+  // might be more than one character.  Replace it with '.'.
+  bool in_decimal_point = false;
+  for (int i = 0; i < length; ++i) {
+    const char c = formatted[i];
+    if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == 'e') {
+      *buffer++ = c;
+      in_decimal_point = false;
+    } else if (!in_decimal_point) {
+      *buffer++ = '.';
+      in_decimal_point = true;
+    }
+  }
+  return buffer;
+}
+
+}  // namespace spvutils
+
+#endif  // LIBSPIRV_UTIL_NUMBER_FORMAT_H_
@@ -0,0 +1,692 @@
+// Copyright (c) 2016 The Khronos Group Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and/or associated documentation files (the
+// "Materials"), to deal in the Materials without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Materials, and to
+// permit persons to whom the Materials are furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Materials.
+//
+// MODIFICATIONS TO THIS FILE MAY MEAN IT NO LONGER ACCURATELY REFLECTS
+// KHRONOS STANDARDS. THE UNMODIFIED, NORMATIVE VERSIONS OF KHRONOS
+// SPECIFICATIONS AND HEADER INFORMATION ARE LOCATED AT
+//    https://www.khronos.org/registry/
+//
+// THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+
+// Locale-independent parsing of numbers from character ranges.  The text
+// accepted is the same as for extracting the number from a std::istream with
+// std::setbase(0) in the classic locale, but without the stream machinery.
+
+#ifndef LIBSPIRV_UTIL_PARSE_NUMBER_H_
+#define LIBSPIRV_UTIL_PARSE_NUMBER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "hex_float.h"
+
+namespace spvutils {
+
+// Returns the value of ch as a hexadecimal digit, or 16 if it is not one.
+inline uint32_t HexDigitValue(char ch) {
+  if (ch >= '0' && ch <= '9') return uint32_t(ch - '0');
+  if (ch >= 'a' && ch <= 'f') return uint32_t(ch - 'a' + 10);
+  if (ch >= 'A' && ch <= 'F') return uint32_t(ch - 'A' + 10);
+  return 16;
+}
+
+// Returns true if ch is white space in the classic locale.
+inline bool IsClassicSpace(char ch) {
+  return ch == ' ' || (ch >= '\t' && ch <= '\r');
+}
+
+// Parses all of the length characters at text as an integer of type T.
+// Leading white space and a sign are allowed.  The base follows from the
+// prefix: "0x" or "0X" for hexadecimal, "0" for octal, and decimal
+// otherwise.  Returns true and sets *value on success.  Fails if there are no
+// digits, if anything follows them, or if the number is out of range for T;
+// the only negative number in range for an unsigned type is zero.  On
+// failure *value is set to zero.
+template <typename T>
+bool ParseInteger(const char* text, size_t length, T* value) {
+  static_assert(std::is_integral<T>::value, "ParseInteger needs an integer");
+  *value = 0;
+  const char* p = text;
+  const char* const end = text + length;
+  while (p != end && IsClassicSpace(*p)) ++p;
+
+  bool negative = false;
+  if (p != end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+
+  uint32_t base = 10;
+  if (p != end && *p == '0') {
+    // The zero of an octal prefix is also a digit of the number, but that of
+    // a hexadecimal prefix is not.
+    base = 8;
+    if (end - p > 1 && (p[1] == 'x' || p[1] == 'X')) {
+      base = 16;
+      p += 2;
+    }
+  }
+
+  // The largest magnitude the number can have, and how far it can get
+  // before appending another digit might exceed that.
+  const uint64_t limit =
+      !negative ? uint64_t(std::numeric_limits<T>::max())
+                : std::is_signed<T>::value
+                      ? uint64_t(std::numeric_limits<T>::max()) + 1
+                      : 0;
+  const uint64_t cutoff = limit / base;
+  const uint32_t cutoff_digit = uint32_t(limit % base);
+
+  const char* const digits = p;
+  uint64_t magnitude = 0;
+  for (; p != end; ++p) {
+    const uint32_t digit = HexDigitValue(*p);
+    if (digit >= base) break;
+    if (magnitude > cutoff || (magnitude == cutoff && digit > cutoff_digit))
+      return false;
+    magnitude = magnitude * base + digit;
+  }
+  if (p == digits || p != end) return false;
+
+  // Negate in unsigned arithmetic so the most negative value works.
+  *value = T(negative ? uint64_t(0) - magnitude : magnitude);
+  return true;
+}
+
+// The range of decimal exponents for which PowerOfTenSignificand knows the
+// significand of the power of ten.
+enum { kMinDecimalExponent = -342, kMaxDecimalExponent = 308 };
+
+// A 128-bit significand, split in two halves.
+struct Significand128 {
+  uint64_t high;
+  uint64_t low;
+};
+
+// Returns the 128 most significant bits of 10^exponent, shifted so that the
+// top bit is set and rounded down, for exponent from kMinDecimalExponent to
+// kMaxDecimalExponent.  These are also the bits of 5^exponent, since the
+// factors of two only move the binary point.
+inline const Significand128& PowerOfTenSignificand(int exponent) {
+  static const std::vector<Significand128> table = [] {
+    // Big numbers are vectors of 32-bit words, least significant first.
+    // Returns the 64 bits of number from position up, where the bits below
+    // zero are zero.
+    auto bits_at = [](const std::vector<uint32_t>& number, int position) {
+      uint64_t result = 0;
+      for (int i = position + 63; i >= position; --i) {
+        result <<= 1;
+        if (i >= 0) result |= (number[i / 32] >> (i % 32)) & 1;
+      }
+      return result;
+    };
+    auto top_bits = [&bits_at](const std::vector<uint32_t>& number) {
+      int top = int(number.size()) * 32 - 1;
+      while (((number[top / 32] >> (top % 32)) & 1) == 0) --top;
+      return Significand128{bits_at(number, top - 63),
+                            bits_at(number, top - 127)};
+    };
+
+    std::vector<Significand128> significands(kMaxDecimalExponent -
+                                             kMinDecimalExponent + 1);
+    // 5^n, which needs 716 bits at most.
+    std::vector<uint32_t> power(24, 0);
+    power[0] = 1;
+    for (int n = 0; n <= kMaxDecimalExponent; ++n) {
+      significands[n - kMinDecimalExponent] = top_bits(power);
+      uint64_t carry = 0;
+      for (auto& word : power) {
+        carry += uint64_t(word) * 5;
+        word = uint32_t(carry);
+        carry >>= 32;
+      }
+    }
+    // floor(2^960 / 5^n), which has at least 128 bits for every n needed.
+    // Dividing by five each time loses nothing, since
+    // floor(floor(x / a) / b) = floor(x / (a * b)).
+    std::vector<uint32_t> reciprocal(31, 0);
+    reciprocal[30] = 1;
+    for (int n = 1; n <= -kMinDecimalExponent; ++n) {
+      uint64_t remainder = 0;
+      for (size_t i = reciprocal.size(); i-- > 0;) {
+        remainder = (remainder << 32) | reciprocal[i];
+        reciprocal[i] = uint32_t(remainder / 5);
+        remainder %= 5;
+      }
+      significands[-n - kMinDecimalExponent] = top_bits(reciprocal);
+    }
+    return significands;
+  }();
+  return table[exponent - kMinDecimalExponent];
+}
+
+// Returns the number of zero bits above the highest set bit of the nonzero
+// value.
+inline int CountLeadingZeros64(uint64_t value) {
+#if defined(__GNUC__)
+  return __builtin_clzll(value);
+#else
+  int count = 0;
+  for (int shift = 32; shift > 0; shift >>= 1) {
+    if ((value >> (64 - shift)) == 0) {
+      count += shift;
+      value <<= shift;
+    }
+  }
+  return count;
+#endif
+}
+
+// Sets *high and *low to the two halves of the 128-bit product of a and b.
+inline void Multiply64(uint64_t a, uint64_t b, uint64_t* high, uint64_t* low) {
+  const uint64_t a_low = a & 0xffffffff;
+  const uint64_t a_high = a >> 32;
+  const uint64_t b_low = b & 0xffffffff;
+  const uint64_t b_high = b >> 32;
+  const uint64_t low_low = a_low * b_low;
+  const uint64_t high_low = a_high * b_low;
+  const uint64_t low_high = a_low * b_high;
+  const uint64_t middle = (low_low >> 32) + (high_low & 0xffffffff) + low_high;
+  *high = a_high * b_high + (high_low >> 32) + (middle >> 32);
+  *low = (middle << 32) | (low_low & 0xffffffff);
+}
+
+// Sets *bits to the bits of the normal float of type HF nearest to
+// significand * 10^exponent, with ties going to even, using the Eisel-Lemire
+// algorithm.  Returns false, without setting *bits, if the significand is
+// zero, if the result would not be a normal number, or if the result can't
+// be decided from 128 bits of the power of ten.
+template <typename HF>
+bool EiselLemire(uint64_t significand, int exponent,
+                 typename HF::uint_type* bits) {
+  if (significand == 0 || exponent < kMinDecimalExponent ||
+      exponent > kMaxDecimalExponent)
+    return false;
+  // The product has 64 bits at the top which matter.  Of those, the ones
+  // below the significand and the bit used to round it are low_bits.
+  const int low_bits = 64 - int(HF::num_fraction_bits) - 3;
+  const uint64_t low_mask = (uint64_t(1) << low_bits) - 1;
+
+  const int leading_zeros = CountLeadingZeros64(significand);
+  significand <<= leading_zeros;
+  // 217706 / 2^16 is close enough to log2(10) for every exponent in range.
+  int64_t biased_exponent = ((int64_t(217706) * exponent) >> 16) + 64 +
+                            int64_t(HF::exponent_bias) - leading_zeros;
+
+  const Significand128& power = PowerOfTenSignificand(exponent);
+  uint64_t high;
+  uint64_t low;
+  Multiply64(significand, power.high, &high, &low);
+  if ((high & low_mask) == low_mask && low + significand < significand) {
+    // The error from truncating the power to 64 bits could carry into the
+    // bits which matter, so use the rest of the power too.
+    uint64_t next_high;
+    uint64_t next_low;
+    Multiply64(significand, power.low, &next_high, &next_low);
+    const uint64_t merged_low = low + next_high;
+    const uint64_t merged_high = high + (merged_low < low ? 1 : 0);
+    if ((merged_high & low_mask) == low_mask && merged_low + 1 == 0 &&
+        next_low + significand < significand)
+      return false;
+    high = merged_high;
+    low = merged_low;
+  }
+
+  const int top_bit = int(high >> 63);
+  uint64_t mantissa = high >> (top_bit + low_bits);
+  biased_exponent -= 1 ^ top_bit;
+  if (low == 0 && (high & low_mask) == 0 && (mantissa & 3) == 1) {
+    // This might be exactly halfway between two floats.  For small positive
+    // exponents, the power is exact, so it is if none of the bits shifted out
+    // are set, and rounds down to even.  Otherwise the power would need more
+    // bits to decide.
+    if (exponent < 0 || exponent > 27) return false;
+    if ((mantissa << (top_bit + low_bits)) == high) mantissa &= ~uint64_t(1);
+  }
+
+  mantissa += mantissa & 1;
+  mantissa >>= 1;
+  if (mantissa >> (HF::num_fraction_bits + 1)) {
+    mantissa >>= 1;
+    ++biased_exponent;
+  }
+  const int64_t max_biased_exponent = (int64_t(1) << HF::num_exponent_bits) - 1;
+  if (biased_exponent <= 0 || biased_exponent >= max_biased_exponent)
+    return false;
+  *bits = typename HF::uint_type(
+      (uint64_t(biased_exponent) << HF::num_fraction_bits) |
+      (mantissa & HF::fraction_encode_mask));
+  return true;
+}
+
+// Sets *bits to the bits of the float of type HF nearest to the decimal
+// number from p up to end, without a sign.  Returns false, without setting
+// *bits, unless the number is in the usual form of digits with an optional
+// point and exponent, it has at most 19 significant digits, and the result
+// is zero or can be found by EiselLemire.
+template <typename HF>
+bool ParseDecimalFloatQuickly(const char* p, const char* end,
+                              typename HF::uint_type* bits) {
+  uint64_t significand = 0;
+  int significant_digits = 0;
+  int exponent = 0;
+  bool seen_digit = false;
+  bool seen_point = false;
+  for (; p != end; ++p) {
+    if (*p == '.') {
+      if (seen_point) return false;
+      seen_point = true;
+      continue;
+    }
+    const uint32_t digit = uint32_t(*p) - '0';
+    if (digit > 9) break;
+    seen_digit = true;
+    if (significant_digits < 19) {
+      if (significand != 0 || digit != 0) {
+        significand = significand * 10 + digit;
+        ++significant_digits;
+      }
+      if (seen_point) --exponent;
+    } else {
+      if (digit != 0) return false;
+      if (!seen_point) ++exponent;
+    }
+  }
+  if (!seen_digit) return false;
+
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    bool negative_exponent = false;
+    if (p != end && (*p == '-' || *p == '+')) negative_exponent = *p++ == '-';
+    if (p == end) return false;
+    // Far beyond the range of any float, but without overflowing.
+    const int exponent_limit = 100000;
+    int written_exponent = 0;
+    for (; p != end; ++p) {
+      const uint32_t digit = uint32_t(*p) - '0';
+      if (digit > 9) return false;
+      written_exponent = std::min(written_exponent * 10 + int(digit),
+                                  exponent_limit);
+    }
+    exponent += negative_exponent ? -written_exponent : written_exponent;
+  }
+  if (p != end) return false;
+
+  if (significand == 0) {
+    *bits = 0;
+    return true;
+  }
+  return EiselLemire<HF>(significand, exponent, bits);
+}
+
+// Parses the rest of a hex float, after its "0x", from the characters from p
+// up to end, with the given sign.  This is the same as reading a HexFloat
+// from a stream, so a significand with more bits than fit is truncated: the
+// bits which don't fit are dropped, both here and by the stream.
+// Returns true and sets *value if the hex float used all the characters.
+template <typename T, typename Traits>
+bool ParseHexFloat(const char* p, const char* end, bool negate_value,
+                   HexFloat<T, Traits>* value) {
+  using HF = HexFloat<T, Traits>;
+  using uint_type = typename HF::uint_type;
+  using int_type = typename HF::int_type;
+
+  bool seen_p = false;
+  bool seen_dot = false;
+  uint_type fraction_index = 0;
+  uint_type fraction = 0;
+  int_type exponent = HF::exponent_bias;
+
+  // Sets the next bit of the fraction, if there is room for it.
+  auto write_fraction_bit = [&fraction, &fraction_index](uint_type bit) {
+    if (fraction_index <= HF::top_bit_left_shift)
+      fraction |= uint_type(bit << (HF::top_bit_left_shift - fraction_index));
+    ++fraction_index;
+  };
+
+  // Strip off leading zeros so we don't have to special-case them later.
+  while (p != end && *p == '0') ++p;
+
+  // Assume denorm "representation" until we hear otherwise.
+  bool is_denorm = true;
+  bool bits_written = false;
+  while (!seen_p && !seen_dot) {
+    if (p == end) return false;
+    if (*p == '.') {
+      seen_dot = true;
+    } else if (*p == 'p') {
+      seen_p = true;
+    } else if (HexDigitValue(*p) < 16) {
+      is_denorm = false;
+      uint32_t number = HexDigitValue(*p);
+      for (int i = 0; i < 4; ++i, number <<= 1) {
+        const uint_type write_bit = (number & 0x8) ? 0x1 : 0x0;
+        if (bits_written) {
+          write_fraction_bit(write_bit);
+          exponent += 1;
+        }
+        bits_written |= write_bit != 0;
+      }
+    } else {
+      return false;
+    }
+    ++p;
+  }
+  bits_written = false;
+  while (seen_dot && !seen_p) {
+    if (p == end) return false;
+    if (*p == 'p') {
+      seen_p = true;
+    } else if (HexDigitValue(*p) < 16) {
+      uint32_t number = HexDigitValue(*p);
+      for (int i = 0; i < 4; ++i, number <<= 1) {
+        const uint_type write_bit = (number & 0x8) ? 0x1 : 0x0;
+        bits_written |= write_bit != 0;
+        if (is_denorm && !bits_written) {
+          exponent -= 1;
+        } else {
+          write_fraction_bit(write_bit);
+        }
+      }
+    } else {
+      return false;
+    }
+    ++p;
+  }
+
+  // The exponent is decimal, and wraps around like the stream's does.
+  bool seen_sign = false;
+  bool negative_exponent = false;
+  uint_type written_exponent = 0;
+  for (; p != end; ++p) {
+    if (*p == '-' || *p == '+') {
+      if (seen_sign) return false;
+      seen_sign = true;
+      negative_exponent = *p == '-';
+    } else if (*p >= '0' && *p <= '9') {
+      written_exponent = uint_type(written_exponent * 10 + uint_type(*p - '0'));
+    } else {
+      return false;
+    }
+  }
+  if (negative_exponent) written_exponent = uint_type(0 - written_exponent);
+  exponent = int_type(uint_type(exponent) + written_exponent);
+
+  bool is_zero = is_denorm && (fraction == 0);
+  if (is_denorm && !is_zero) {
+    fraction = uint_type(fraction << 1);
+    exponent -= 1;
+  } else if (is_zero) {
+    exponent = 0;
+  }
+
+  if (exponent <= 0 && !is_zero) {
+    fraction >>= 1;
+    fraction |= static_cast<uint_type>(1) << HF::top_bit_left_shift;
+  }
+
+  fraction = (fraction >> HF::fraction_right_shift) & HF::fraction_encode_mask;
+
+  const int_type max_exponent =
+      SetBits<uint_type, 0, HF::num_exponent_bits>::get;
+
+  // Handle actual denorm numbers
+  while (exponent < 0 && !is_zero) {
+    fraction >>= 1;
+    exponent += 1;
+
+    fraction &= HF::fraction_encode_mask;
+    if (fraction == 0) {
+      // We have underflowed our fraction. We should clamp to zero.
+      is_zero = true;
+      exponent = 0;
+    }
+  }
+
+  // We have overflowed so we should be inf/-inf.
+  if (exponent > max_exponent) {
+    exponent = max_exponent;
+    fraction = 0;
+  }
+
+  uint_type output_bits = static_cast<uint_type>(negate_value ? 1 : 0)
+                          << HF::top_bit_left_shift;
+  output_bits |= fraction;
+  output_bits |= (exponent << HF::exponent_left_shift) & HF::exponent_mask;
+  value->set_value(BitwiseCast<T>(output_bits));
+  return true;
+}
+
+// Rounds the double with the given bits to the nearest 16-bit float.  A
+// double exactly halfway between two 16-bit floats goes to the one with the
+// larger magnitude if tie_direction is positive, the smaller if it is
+// negative, and the even one if it is zero.  Returns true and sets *result on
+// success, or returns false if the double is infinite, NaN, or too big for a
+// 16-bit float.
+inline bool RoundDoubleToFloat16(uint64_t bits, int tie_direction,
+                                 uint16_t* result) {
+  const uint16_t sign = uint16_t((bits >> 48) & 0x8000);
+  const int biased_exponent = int((bits >> 52) & 0x7ff);
+  if (biased_exponent == 0x7ff) return false;
+  if (biased_exponent == 0) {
+    // Zero, or far too small to round to anything else.
+    *result = sign;
+    return true;
+  }
+  // The double is significand * 2^(exponent - 52).  The last bit of the
+  // result is worth 2^(exponent - 10), or 2^-24 if it is subnormal.
+  const uint64_t significand =
+      (bits & 0xfffffffffffffULL) | (uint64_t(1) << 52);
+  const int exponent = biased_exponent - 1023;
+  const int last_bit = std::max(exponent - 10, -24);
+  const int shift = last_bit - (exponent - 52);
+  if (shift >= 54) {
+    // Less than half of the smallest subnormal.
+    *result = sign;
+    return true;
+  }
+  uint64_t rounded = significand >> shift;
+  const uint64_t remainder = significand & ((uint64_t(1) << shift) - 1);
+  const uint64_t half = uint64_t(1) << (shift - 1);
+  if (remainder > half ||
+      (remainder == half &&
+       (tie_direction > 0 || (tie_direction == 0 && (rounded & 1))))) {
+    ++rounded;
+  }
+
+  if (last_bit == -24) {
+    // Subnormals, and the normals with the smallest exponent, are just the
+    // multiple of the last bit.
+    *result = uint16_t(sign | rounded);
+    return true;
+  }
+  int result_exponent = exponent + 15;
+  if (rounded == (1 << 11)) {
+    rounded >>= 1;
+    ++result_exponent;
+  }
+  if (result_exponent >= 0x1f) return false;
+  *result = uint16_t(sign | (result_exponent << 10) | (rounded & 0x3ff));
+  return true;
+}
+
+// Multiplies the number with the given decimal digits, most significant
+// first, by factor, which is at most 10.
+inline void MultiplyDecimalDigits(uint32_t factor, std::string* digits) {
+  uint32_t carry = 0;
+  for (auto it = digits->rbegin(); it != digits->rend(); ++it) {
+    const uint32_t product = uint32_t(*it - '0') * factor + carry;
+    *it = char('0' + product % 10);
+    carry = product / 10;
+  }
+  if (carry) digits->insert(digits->begin(), char('0' + carry));
+}
+
+// Removes the trailing zeros of the decimal digits of a number, adding one to
+// *exponent for each, and returns the result.
+inline std::string TrimDecimalDigits(std::string digits, long* exponent) {
+  while (!digits.empty() && digits.back() == '0') {
+    digits.pop_back();
+    ++*exponent;
+  }
+  return digits;
+}
+
+// Compares the magnitude of the decimal float in the length characters at
+// text, which a stream can read as a double, with the magnitude of the finite
+// double with the given bits.  Returns a negative number, zero, or a positive
+// number as the decimal is less than, equal to, or greater than the double.
+inline int CompareDecimalWithDouble(const char* text, size_t length,
+                                    uint64_t bits) {
+  // Each number is written as its significant decimal digits, without
+  // leading or trailing zeros, times ten to the power of an exponent.
+  std::string decimal_digits;
+  long decimal_exponent = 0;
+  const char* p = text;
+  const char* const end = text + length;
+  while (p != end && IsClassicSpace(*p)) ++p;
+  if (p != end && (*p == '+' || *p == '-')) ++p;
+  bool after_point = false;
+  for (; p != end; ++p) {
+    if (*p == '.') {
+      after_point = true;
+      continue;
+    }
+    if (*p < '0' || *p > '9') break;
+    if (after_point) --decimal_exponent;
+    if (*p != '0' || !decimal_digits.empty()) decimal_digits.push_back(*p);
+  }
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    const bool negative = p != end && *p == '-';
+    if (p != end && (*p == '+' || *p == '-')) ++p;
+    long exponent = 0;
+    for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+      // Far beyond any exponent which matters.
+      if (exponent < 100000) exponent = exponent * 10 + (*p - '0');
+    }
+    decimal_exponent += negative ? -exponent : exponent;
+  }
+  decimal_digits = TrimDecimalDigits(decimal_digits, &decimal_exponent);
+
+  // The double is significand * 2^binary_exponent.
+  const int biased_exponent = int((bits >> 52) & 0x7ff);
+  uint64_t significand = bits & 0xfffffffffffffULL;
+  if (biased_exponent) significand |= uint64_t(1) << 52;
+  int binary_exponent = std::max(biased_exponent, 1) - 1075;
+  std::string double_digits;
+  long double_exponent = 0;
+  if (significand) {
+    while (!(significand & 1)) {
+      significand >>= 1;
+      ++binary_exponent;
+    }
+    double_digits = std::to_string(significand);
+    // Multiplying by 2^-n is multiplying by 5^n and dividing by 10^n.
+    for (; binary_exponent > 0; --binary_exponent)
+      MultiplyDecimalDigits(2, &double_digits);
+    for (; binary_exponent < 0; ++binary_exponent) {
+      MultiplyDecimalDigits(5, &double_digits);
+      --double_exponent;
+    }
+    double_digits = TrimDecimalDigits(double_digits, &double_exponent);
+  }
+
+  if (decimal_digits.empty() || double_digits.empty())
+    return int(!decimal_digits.empty()) - int(!double_digits.empty());
+  // Compare the positions of the leading digits, then the digits.
+  const long decimal_top = long(decimal_digits.size()) + decimal_exponent;
+  const long double_top = long(double_digits.size()) + double_exponent;
+  if (decimal_top != double_top) return decimal_top < double_top ? -1 : 1;
+  return decimal_digits.compare(double_digits);
+}
+
+// Parses all of the length characters at text as a float by extracting a
+// HexFloat from a stream.  Returns true and sets *value on success.
+template <typename T>
+bool ParseFloatFromStream(const char* text, size_t length,
+                          HexFloat<FloatProxy<T>>* value) {
+  std::istringstream stream(std::string(text, length));
+  stream >> std::setbase(0);
+  stream >> *value;
+  // We should have read something, it should have been all the text, and it
+  // should have been in range.
+  return length != 0 && !stream.bad() && stream.eof() && !stream.fail();
+}
+
+// Like ParseFloatFromStream, but for a 16-bit float, which the stream can't
+// read unless it is a hex float.  So the text is read as a double and then
+// rounded again.  Since every 16-bit float and every point halfway between
+// two of them is a double, this gives the nearest 16-bit float to the text,
+// except when the double lands exactly halfway and the text does not.  Then
+// the text itself decides which way to round.
+inline bool ParseFloatFromStream(const char* text, size_t length,
+                                 HexFloat<FloatProxy<Float16>>* value) {
+  HexFloat<FloatProxy<double>> wide(0.0);
+  if (!ParseFloatFromStream(text, length, &wide)) return false;
+  const uint64_t wide_bits = wide.value().data();
+  uint16_t down;
+  uint16_t up;
+  uint16_t bits;
+  if (!RoundDoubleToFloat16(wide_bits, -1, &down)) return false;
+  if (RoundDoubleToFloat16(wide_bits, 1, &up) && up == down) {
+    bits = down;
+  } else if (!RoundDoubleToFloat16(
+                 wide_bits, CompareDecimalWithDouble(text, length, wide_bits),
+                 &bits)) {
+    return false;
+  }
+  value->set_value(FloatProxy<Float16>(bits));
+  return true;
+}
+
+// Parses all of the length characters at text as a float, for a float,
+// double or Float16.  The text accepted and the value are the same as for
+// reading a HexFloat from a stream: decimal floats are rounded to nearest,
+// ties to even, and fail if they are out of range; hex floats have any bits
+// which don't fit truncated.  Decimal floats with up to 19 significant digits
+// and no unusual syntax, and all hex floats, are parsed without the stream.
+// Returns true and sets *value on success.
+template <typename T>
+bool ParseFloat(const char* text, size_t length,
+                HexFloat<FloatProxy<T>>* value) {
+  using HF = HexFloat<FloatProxy<T>>;
+  const char* p = text;
+  const char* const end = text + length;
+  const bool negative = p != end && *p == '-';
+  if (negative) ++p;
+  if (end - p >= 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+    return ParseHexFloat(p + 2, end, negative, value);
+
+  typename HF::uint_type bits;
+  if (ParseDecimalFloatQuickly<HF>(p, end, &bits)) {
+    if (negative) bits |= HF::sign_mask;
+    value->set_value(FloatProxy<T>(bits));
+    return true;
+  }
+  return ParseFloatFromStream(text, length, value);
+}
+
+}  // namespace spvutils
+
+#endif  // LIBSPIRV_UTIL_PARSE_NUMBER_H_
@@ -48,14 +48,15 @@ namespace {
 /// @param[in] operandTable operand lookup table
 /// @param[in] type of the operand
 /// @param[in] textValue word of text to be parsed
+/// @param[in] text_length number of characters in the word
 /// @param[out] pValue where the resulting value is written
 ///
 /// @return result code
 spv_result_t spvTextParseMaskOperand(const spv_operand_table operandTable,
                                      const spv_operand_type_t type,
-                                     const char* textValue, uint32_t* pValue) {
+                                     const char* textValue, size_t text_length,
+                                     uint32_t* pValue) {
   if (textValue == nullptr) return SPV_ERROR_INVALID_TEXT;
-  size_t text_length = strlen(textValue);
   if (text_length == 0) return SPV_ERROR_INVALID_TEXT;
   const char* text_end = textValue + text_length;
 
@@ -182,9 +183,9 @@ bool AssemblyGrammar::isValid() const {
   return operandTable_ && opcodeTable_ && extInstTable_;
 }
 
-spv_result_t AssemblyGrammar::lookupOpcode(const char* name,
+spv_result_t AssemblyGrammar::lookupOpcode(const char* name, size_t name_len,
                                            spv_opcode_desc* desc) const {
-  return spvOpcodeTableNameLookup(opcodeTable_, name, desc);
+  return spvOpcodeTableNameLookup(opcodeTable_, name, name_len, desc);
 }
 
 spv_result_t AssemblyGrammar::lookupOpcode(SpvOp opcode,
@@ -205,12 +206,16 @@ spv_result_t AssemblyGrammar::lookupOperand(spv_operand_type_t type,
 }
 
 spv_result_t AssemblyGrammar::lookupSpecConstantOpcode(const char* name,
+                                                       size_t name_len,
                                                        SpvOp* opcode) const {
   const auto* last = kOpSpecConstantOpcodes + kNumOpSpecConstantOpcodes;
   const auto* found =
       std::find_if(kOpSpecConstantOpcodes, last,
-                   [name](const SpecConstantOpcodeEntry& entry) {
-                     return 0 == strcmp(name, entry.name);
+                   [name, name_len](const SpecConstantOpcodeEntry& entry) {
+                     // The name may contain null characters, so compare
+                     // lengths first.
+                     return strlen(entry.name) == name_len &&
+                            0 == memcmp(entry.name, name, name_len);
                    });
   if (found == last) return SPV_ERROR_INVALID_LOOKUP;
   *opcode = found->opcode;
@@ -231,12 +236,24 @@ spv_result_t AssemblyGrammar::lookupSpecConstantOpcode(SpvOp opcode) const {
 spv_result_t AssemblyGrammar::parseMaskOperand(const spv_operand_type_t type,
                                                const char* textValue,
                                                uint32_t* pValue) const {
-  return spvTextParseMaskOperand(operandTable_, type, textValue, pValue);
+  if (textValue == nullptr) return SPV_ERROR_INVALID_TEXT;
+  return parseMaskOperand(type, textValue, strlen(textValue), pValue);
 }
+
+spv_result_t AssemblyGrammar::parseMaskOperand(const spv_operand_type_t type,
+                                               const char* textValue,
+                                               size_t text_length,
+                                               uint32_t* pValue) const {
+  return spvTextParseMaskOperand(operandTable_, type, textValue, text_length,
+                                 pValue);
+}
+
 spv_result_t AssemblyGrammar::lookupExtInst(spv_ext_inst_type_t type,
                                             const char* textValue,
+                                            size_t text_length,
                                             spv_ext_inst_desc* extInst) const {
-  return spvExtInstTableNameLookup(extInstTable_, type, textValue, extInst);
+  return spvExtInstTableNameLookup(extInstTable_, type, textValue, text_length,
+                                   extInst);
 }
 
 spv_result_t AssemblyGrammar::lookupExtInst(spv_ext_inst_type_t type,
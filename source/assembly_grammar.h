@@ -48,7 +48,8 @@ class AssemblyGrammar {
   // Fills in the desc parameter with the information about the opcode
   // of the given name. Returns SPV_SUCCESS if the opcode was found, and
   // SPV_ERROR_INVALID_LOOKUP if the opcode does not exist.
-  spv_result_t lookupOpcode(const char* name, spv_opcode_desc* desc) const;
+  spv_result_t lookupOpcode(const char* name, size_t name_len,
+                            spv_opcode_desc* desc) const;
 
   // Fills in the desc parameter with the information about the opcode
   // of the valid. Returns SPV_SUCCESS if the opcode was found, and
@@ -72,7 +73,8 @@ class AssemblyGrammar {
   // the integer add opcode for OpSpecConstantOp.  On success, returns
   // SPV_SUCCESS and sends the discovered operation code through the opcode
   // parameter.  On failure, returns SPV_ERROR_INVALID_LOOKUP.
-  spv_result_t lookupSpecConstantOpcode(const char* name, SpvOp* opcode) const;
+  spv_result_t lookupSpecConstantOpcode(const char* name, size_t name_len,
+                                        SpvOp* opcode) const;
 
   // Returns SPV_SUCCESS if the given opcode is valid as the opcode operand
   // to OpSpecConstantOp.
@@ -90,10 +92,17 @@ class AssemblyGrammar {
   spv_result_t parseMaskOperand(const spv_operand_type_t type,
                                 const char* textValue, uint32_t* pValue) const;
 
+  // Parses a mask expression of text_length characters at textValue, as
+  // above.
+  spv_result_t parseMaskOperand(const spv_operand_type_t type,
+                                const char* textValue, size_t text_length,
+                                uint32_t* pValue) const;
+
   // Writes the extended operand with the given type and text to the *extInst
   // parameter.
   // Returns SPV_SUCCESS if the value could be found.
   spv_result_t lookupExtInst(spv_ext_inst_type_t type, const char* textValue,
+                             size_t text_length,
                              spv_ext_inst_desc* extInst) const;
 
   // Writes the extended operand with the given type and first encoded word
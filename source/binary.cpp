@@ -29,8 +29,10 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <iterator>
 #include <limits>
 #include <unordered_map>
+#include <vector>
 
 #include "assembly_grammar.h"
 #include "diagnostic.h"
@@ -61,6 +63,10 @@ spv_result_t spvBinaryHeaderGet(const spv_const_binary binary,
   return SPV_SUCCESS;
 }
 
+uint32_t spvDenseIdBound(uint32_t bound, size_t num_words) {
+  return bound <= num_words ? bound : 0;
+}
+
 // TODO(dneto): This API is not powerful enough in the case that the
 // number and type of operands are not known until partway through parsing
 // the operation.  This happens when enum operands might have different number
@@ -104,6 +110,46 @@ spv_operand_type_t spvBinaryOperandInfo(const uint32_t word,
 
 namespace {
 
+// Maps IDs to values of type T.  IDs below a chosen bound are kept in a flat
+// array indexed by ID, and any others in a hash map.  Choose the bound from
+// the module header to avoid hashing in the common case.
+template <typename T>
+class IdMap {
+ public:
+  // Removes all entries, and stores IDs less than dense_bound in a flat array.
+  void reset(uint32_t dense_bound) {
+    dense_.assign(dense_bound, Slot());
+    sparse_.clear();
+  }
+
+  // Returns a pointer to the value for the given ID, or nullptr if the ID
+  // has no value.
+  const T* find(uint32_t id) const {
+    if (id < dense_.size())
+      return dense_[id].present ? &dense_[id].value : nullptr;
+    const auto iter = sparse_.find(id);
+    return iter == sparse_.end() ? nullptr : &iter->second;
+  }
+
+  // Sets the value for the given ID.
+  void set(uint32_t id, const T& value) {
+    if (id < dense_.size()) {
+      dense_[id].present = true;
+      dense_[id].value = value;
+    } else {
+      sparse_[id] = value;
+    }
+  }
+
+ private:
+  struct Slot {
+    bool present;
+    T value;
+  };
+  std::vector<Slot> dense_;
+  std::unordered_map<uint32_t, T> sparse_;
+};
+
 // A SPIR-V binary parser.  A parser instance communicates detailed parse
 // results via callbacks.
 class Parser {
@@ -140,18 +186,15 @@ class Parser {
   // Parses an instruction operand with the given type, for an instruction
   // starting at inst_offset words into the SPIR-V binary.
   // If the SPIR-V binary is the same endianness as the host, then the
-  // endian_converted_inst_words parameter is ignored.  Otherwise, this method
+  // endian_converted_words_ member is ignored.  Otherwise, this method
   // appends the words for this operand, converted to host native endianness,
-  // to the end of endian_converted_inst_words.  This method also updates the
-  // expected_operands parameter, and the scalar members of the inst parameter.
+  // to the end of endian_converted_words_.  This method also updates the
+  // expected_operands_ member, and the scalar members of the inst parameter.
   // On success, returns SPV_SUCCESS, advances past the operand, and pushes a
-  // new entry on to the operands vector.  Otherwise returns an error code and
+  // new entry on to the operands_ member.  Otherwise returns an error code and
   // issues a diagnostic.
   spv_result_t parseOperand(size_t inst_offset, spv_parsed_instruction_t* inst,
-                            const spv_operand_type_t type,
-                            std::vector<uint32_t>* endian_converted_inst_words,
-                            std::vector<spv_parsed_operand_t>* operands,
-                            spv_operand_pattern_t* expected_operands);
+                            const spv_operand_type_t type);
 
   // Records the numeric type for an operand according to the type information
   // associated with the given non-zero type Id.  This can fail if the type Id
@@ -213,6 +256,26 @@ class Parser {
   const spv_parsed_instruction_fn_t
       parsed_instruction_fn_;  // Parsed instruction callback
 
+  // Scratch storage for the instruction being parsed.  These are cleared at
+  // the start of each instruction, but keep their capacity, so that parsing
+  // a module does not allocate memory for every instruction.
+
+  // If the module's endianness is different from the host native endianness,
+  // then this contains the endian-translated words in the instruction.
+  // Otherwise it only contains the first word of the instruction.
+  std::vector<uint32_t> endian_converted_words_;
+  // The operands parsed so far.  After a successful parse of an instruction,
+  // its operands member points into this vector's storage.
+  std::vector<spv_parsed_operand_t> operands_;
+  // Maintains the ordered list of expected operand types.
+  // For many instructions we only need the {numTypes, operandTypes}
+  // entries in the opcode description.  However, sometimes we need to modify
+  // the list as we parse the operands. This occurs when an operand
+  // has its own logical operands (such as the LocalSize operand for
+  // ExecutionMode), or for extended instructions that may have their
+  // own operands depending on the selected extended instruction.
+  spv_operand_pattern_t expected_operands_;
+
   // Describes the format of a typed literal number.
   struct NumberType {
     spv_number_kind_t type;
@@ -227,7 +290,8 @@ class Parser {
           num_words(num_words_arg),
           diagnostic(diagnostic_arg),
           word_index(0),
-          endian() {}
+          endian(),
+          requires_endian_conversion(false) {}
     State() : State(0, 0, nullptr) {}
     const uint32_t* words;       // Words in the binary SPIR-V module.
     size_t num_words;            // Number of words in the module.
@@ -241,12 +305,11 @@ class Parser {
     // Maps a result ID to its type ID.  By convention:
     //  - a result ID that is a type definition maps to itself.
     //  - a result ID without a type maps to 0.  (E.g. for OpLabel)
-    std::unordered_map<uint32_t, uint32_t> id_to_type_id;
+    IdMap<uint32_t> id_to_type_id;
     // Maps a type ID to its number type description.
-    std::unordered_map<uint32_t, NumberType> type_id_to_number_type_info;
+    IdMap<NumberType> type_id_to_number_type_info;
     // Maps an ExtInstImport id to the extended instruction type.
-    std::unordered_map<uint32_t, spv_ext_inst_type_t>
-        import_id_to_ext_inst_type;
+    IdMap<spv_ext_inst_type_t> import_id_to_ext_inst_type;
   } _;
 };
 
@@ -285,6 +348,12 @@ spv_result_t Parser::parseModule() {
     return diagnostic(SPV_ERROR_INTERNAL)
            << "Internal error: unhandled header parse failure";
   }
+  // Index the ID maps by ID, unless the ID bound is too large for that.
+  const uint32_t dense_id_bound = spvDenseIdBound(header.bound, _.num_words);
+  _.id_to_type_id.reset(dense_id_bound);
+  _.type_id_to_number_type_info.reset(dense_id_bound);
+  _.import_id_to_ext_inst_type.reset(dense_id_bound);
+
   if (parsed_header_fn_) {
     if (auto error = parsed_header_fn_(user_data_, _.endian, header.magic,
                                        header.version, header.generator,
@@ -311,24 +380,10 @@ spv_result_t Parser::parseInstruction() {
 
   const uint32_t first_word = peek();
 
-  // TODO(dneto): If it's too expensive to construct the following "words"
-  // and "operands" vectors for each instruction, each instruction, then make
-  // them class data members instead, and clear them here.
-
-  // If the module's endianness is different from the host native endianness,
-  // then converted_words contains the the endian-translated words in the
-  // instruction.
-  std::vector<uint32_t> endian_converted_words = {first_word};
-  if (_.requires_endian_conversion) {
-    // Most instructions have fewer than 25 words.
-    endian_converted_words.reserve(25);
-  }
-
-  // After a successful parse of the instruction, the inst.operands member
-  // will point to this vector's storage.
-  std::vector<spv_parsed_operand_t> operands;
-  // Most instructions have fewer than 25 logical operands.
-  operands.reserve(25);
+  // Reuse the scratch storage from the previous instruction.
+  endian_converted_words_.clear();
+  endian_converted_words_.push_back(first_word);
+  operands_.clear();
 
   assert(_.word_index < _.num_words);
   // Decompose and check the first word.
@@ -347,20 +402,15 @@ spv_result_t Parser::parseInstruction() {
   const size_t inst_offset = _.word_index;
   _.word_index++;
 
-  // Maintains the ordered list of expected operand types.
-  // For many instructions we only need the {numTypes, operandTypes}
-  // entries in opcode_desc.  However, sometimes we need to modify
-  // the list as we parse the operands. This occurs when an operand
-  // has its own logical operands (such as the LocalSize operand for
-  // ExecutionMode), or for extended instructions that may have their
-  // own operands depending on the selected extended instruction.
-  spv_operand_pattern_t expected_operands(
-      opcode_desc->operandTypes,
-      opcode_desc->operandTypes + opcode_desc->numTypes);
+  // Append rather than assign: inserting into an empty deque reserves space
+  // at its front, which would allocate a new block for every instruction.
+  expected_operands_.clear();
+  for (uint16_t i = 0; i < opcode_desc->numTypes; ++i)
+    expected_operands_.push_back(opcode_desc->operandTypes[i]);
 
   while (_.word_index < inst_offset + inst_word_count) {
     const uint16_t inst_word_index = uint16_t(_.word_index - inst_offset);
-    if (expected_operands.empty()) {
+    if (expected_operands_.empty()) {
       return diagnostic() << "Invalid instruction Op" << opcode_desc->name
                           << " starting at word " << inst_offset
                           << ": expected no more operands after "
@@ -369,17 +419,14 @@ spv_result_t Parser::parseInstruction() {
                           << inst_word_count << ".";
     }
 
-    spv_operand_type_t type = spvTakeFirstMatchableOperand(&expected_operands);
+    spv_operand_type_t type =
+        spvTakeFirstMatchableOperand(&expected_operands_);
 
-    if (auto error =
-            parseOperand(inst_offset, &inst, type, &endian_converted_words,
-                         &operands, &expected_operands)) {
-      return error;
-    }
+    if (auto error = parseOperand(inst_offset, &inst, type)) return error;
   }
 
-  if (!expected_operands.empty() &&
-      !spvOperandIsOptional(expected_operands.front())) {
+  if (!expected_operands_.empty() &&
+      !spvOperandIsOptional(expected_operands_.front())) {
     return diagnostic() << "End of input reached while decoding Op"
                         << opcode_desc->name << " starting at word "
                         << inst_offset << ": expected more operands after "
@@ -400,15 +447,16 @@ spv_result_t Parser::parseInstruction() {
   // performed, then the vector only contains the initial opcode/word-count
   // word.
   assert(!_.requires_endian_conversion ||
-         (inst_word_count == endian_converted_words.size()));
-  assert(_.requires_endian_conversion || (endian_converted_words.size() == 1));
+         (inst_word_count == endian_converted_words_.size()));
+  assert(_.requires_endian_conversion ||
+         (endian_converted_words_.size() == 1));
 
   recordNumberType(inst_offset, &inst);
 
   if (_.requires_endian_conversion) {
     // We must wait until here to set this pointer, because the vector might
     // have been be resized while we accumulated its elements.
-    inst.words = endian_converted_words.data();
+    inst.words = endian_converted_words_.data();
   } else {
     // If no conversion is required, then just point to the underlying binary.
     // This saves time and space.
@@ -418,8 +466,8 @@ spv_result_t Parser::parseInstruction() {
 
   // We must wait until here to set this pointer, because the vector might
   // have been be resized while we accumulated its elements.
-  inst.operands = operands.data();
-  inst.num_operands = uint16_t(operands.size());
+  inst.operands = operands_.data();
+  inst.num_operands = uint16_t(operands_.size());
 
   // Issue the callback.  The callee should know that all the storage in inst
   // is transient, and will disappear immediately afterward.
@@ -432,10 +480,7 @@ spv_result_t Parser::parseInstruction() {
 
 spv_result_t Parser::parseOperand(size_t inst_offset,
                                   spv_parsed_instruction_t* inst,
-                                  const spv_operand_type_t type,
-                                  std::vector<uint32_t>* words,
-                                  std::vector<spv_parsed_operand_t>* operands,
-                                  spv_operand_pattern_t* expected_operands) {
+                                  const spv_operand_type_t type) {
   // We'll fill in this result as we go along.
   spv_parsed_operand_t parsed_operand;
   parsed_operand.offset = uint16_t(_.word_index - inst_offset);
@@ -474,16 +519,16 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
       inst->result_id = word;
       // Save the result ID to type ID mapping.
       // In the grammar, type ID always appears before result ID.
-      if (_.id_to_type_id.find(inst->result_id) != _.id_to_type_id.end())
+      if (_.id_to_type_id.find(inst->result_id))
         return diagnostic(SPV_ERROR_INVALID_ID) << "Id " << inst->result_id
                                                 << " is defined more than once";
       // Record it.
       // A regular value maps to its type.  Some instructions (e.g. OpLabel)
       // have no type Id, and will map to 0.  The result Id for a
       // type-generating instruction (e.g. OpTypeInt) maps to itself.
-      _.id_to_type_id[inst->result_id] = spvOpcodeGeneratesType(inst->opcode)
-                                             ? inst->result_id
-                                             : inst->type_id;
+      _.id_to_type_id.set(inst->result_id, spvOpcodeGeneratesType(inst->opcode)
+                                               ? inst->result_id
+                                               : inst->type_id);
       break;
 
     case SPV_OPERAND_TYPE_ID:
@@ -494,13 +539,13 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
       if (inst->opcode == SpvOpExtInst && parsed_operand.offset == 3) {
         // The current word is the extended instruction set Id.
         // Set the extended instruction set type for the current instruction.
-        auto ext_inst_type_iter = _.import_id_to_ext_inst_type.find(word);
-        if (ext_inst_type_iter == _.import_id_to_ext_inst_type.end()) {
+        const auto ext_inst_type = _.import_id_to_ext_inst_type.find(word);
+        if (!ext_inst_type) {
           return diagnostic(SPV_ERROR_INVALID_ID)
                  << "OpExtInst set Id " << word
                  << " does not reference an OpExtInstImport result Id";
         }
-        inst->ext_inst_type = ext_inst_type_iter->second;
+        inst->ext_inst_type = *ext_inst_type;
       }
       break;
 
@@ -517,7 +562,7 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
       spv_ext_inst_desc ext_inst;
       if (grammar_.lookupExtInst(inst->ext_inst_type, word, &ext_inst))
         return diagnostic() << "Invalid extended instruction number: " << word;
-      spvPrependOperandTypes(ext_inst->operandTypes, expected_operands);
+      spvPrependOperandTypes(ext_inst->operandTypes, &expected_operands_);
     } break;
 
     case SPV_OPERAND_TYPE_SPEC_CONSTANT_OP_NUMBER: {
@@ -537,7 +582,8 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
       assert(opcode_entry->hasType);
       assert(opcode_entry->hasResult);
       assert(opcode_entry->numTypes >= 2);
-      spvPrependOperandTypes(opcode_entry->operandTypes + 2, expected_operands);
+      spvPrependOperandTypes(opcode_entry->operandTypes + 2,
+                             &expected_operands_);
     } break;
 
     case SPV_OPERAND_TYPE_LITERAL_INTEGER:
@@ -557,13 +603,12 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
         // The literal operands have the same type as the value
         // referenced by the selector Id.
         const uint32_t selector_id = peekAt(inst_offset + 1);
-        const auto type_id_iter = _.id_to_type_id.find(selector_id);
-        if (type_id_iter == _.id_to_type_id.end() ||
-            type_id_iter->second == 0) {
+        const uint32_t* type_id_ptr = _.id_to_type_id.find(selector_id);
+        if (!type_id_ptr || *type_id_ptr == 0) {
           return diagnostic() << "Invalid OpSwitch: selector id " << selector_id
                               << " has no type";
         }
-        uint32_t type_id = type_id_iter->second;
+        uint32_t type_id = *type_id_ptr;
 
         if (selector_id == type_id) {
           // Recall that by convention, a result ID that is a type definition
@@ -634,7 +679,7 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
         // We must have parsed a valid result ID.  It's a condition
         // of the grammar, and we only accept non-zero result Ids.
         assert(inst->result_id);
-        _.import_id_to_ext_inst_type[inst->result_id] = ext_inst_type;
+        _.import_id_to_ext_inst_type.set(inst->result_id, ext_inst_type);
       }
     } break;
 
@@ -669,7 +714,7 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
                             << " operand: " << word;
       }
       // Prepare to accept operands to this operand, if needed.
-      spvPrependOperandTypes(entry->operandTypes, expected_operands);
+      spvPrependOperandTypes(entry->operandTypes, &expected_operands_);
     } break;
 
     case SPV_OPERAND_TYPE_FP_FAST_MATH_MODE:
@@ -703,7 +748,7 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
                    << mask;
           }
           remaining_word ^= mask;
-          spvPrependOperandTypes(entry->operandTypes, expected_operands);
+          spvPrependOperandTypes(entry->operandTypes, &expected_operands_);
         }
       }
       if (word == 0) {
@@ -711,7 +756,7 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
         spv_operand_desc entry;
         if (SPV_SUCCESS == grammar_.lookupOperand(type, 0, &entry)) {
           // Prepare for its operands, if any.
-          spvPrependOperandTypes(entry->operandTypes, expected_operands);
+          spvPrependOperandTypes(entry->operandTypes, &expected_operands_);
         }
       }
     } break;
@@ -722,7 +767,7 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
   assert(int(SPV_OPERAND_TYPE_FIRST_CONCRETE_TYPE) <= int(parsed_operand.type));
   assert(int(SPV_OPERAND_TYPE_LAST_CONCRETE_TYPE) >= int(parsed_operand.type));
 
-  operands->push_back(parsed_operand);
+  operands_.push_back(parsed_operand);
 
   const size_t index_after_operand = _.word_index + parsed_operand.num_words;
 
@@ -738,12 +783,14 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
     if (convert_operand_endianness) {
       const spv_endianness_t endianness = _.endian;
       std::transform(_.words + _.word_index, _.words + index_after_operand,
-                     words->end(), [endianness](const uint32_t raw_word) {
+                     std::back_inserter(endian_converted_words_),
+                     [endianness](const uint32_t raw_word) {
                        return spvFixWord(raw_word, endianness);
                      });
     } else {
-      words->insert(words->end(), _.words + _.word_index,
-                    _.words + index_after_operand);
+      endian_converted_words_.insert(endian_converted_words_.end(),
+                                     _.words + _.word_index,
+                                     _.words + index_after_operand);
     }
   }
 
@@ -756,11 +803,11 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
 spv_result_t Parser::setNumericTypeInfoForType(
     spv_parsed_operand_t* parsed_operand, uint32_t type_id) {
   assert(type_id != 0);
-  auto type_info_iter = _.type_id_to_number_type_info.find(type_id);
-  if (type_info_iter == _.type_id_to_number_type_info.end()) {
+  const NumberType* type_info = _.type_id_to_number_type_info.find(type_id);
+  if (!type_info) {
     return diagnostic() << "Type Id " << type_id << " is not a type";
   }
-  const NumberType& info = type_info_iter->second;
+  const NumberType& info = *type_info;
   if (info.type == SPV_NUMBER_NONE) {
     // This is a valid type, but for something other than a scalar number.
     return diagnostic() << "Type Id " << type_id
@@ -787,7 +834,7 @@ void Parser::recordNumberType(size_t inst_offset,
       info.bit_width = peekAt(inst_offset + 2);
     }
     // The *result* Id of a type generating instruction is the type Id.
-    _.type_id_to_number_type_info[inst->result_id] = info;
+    _.type_id_to_number_type_info.set(inst->result_id, info);
   }
 }
 
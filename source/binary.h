@@ -49,4 +49,12 @@ spv_operand_type_t spvBinaryOperandInfo(const uint32_t word,
                                         const spv_operand_table operand_table,
                                         spv_operand_desc* operand_entry);
 
+// Returns the bound to use for tables indexed directly by ID, given a module's
+// declared ID bound and its size in words.  That is the declared bound, or 0
+// if such tables should not be allocated and IDs should be hashed instead.
+// Any bound is valid, but every ID defined by a module takes at least two of
+// its words, so a larger bound than the word count would leave most slots of
+// the tables unused, and would let a tiny module demand huge tables.
+uint32_t spvDenseIdBound(uint32_t bound, size_t num_words);
+
 #endif  // LIBSPIRV_BINARY_H_
@@ -84,8 +84,8 @@ spv_result_t spvDiagnosticPrint(const spv_diagnostic diagnostic) {
 namespace libspirv {
 
 DiagnosticStream::~DiagnosticStream() {
-  if (pDiagnostic_ && error_ != SPV_FAILED_MATCH) {
-    *pDiagnostic_ = spvDiagnosticCreate(&position_, stream_.str().c_str());
+  if (stream_) {
+    *pDiagnostic_ = spvDiagnosticCreate(&position_, stream_->str().c_str());
   }
 }
 
@@ -28,6 +28,7 @@
 #define LIBSPIRV_DIAGNOSTIC_H_
 
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <utility>
 
@@ -58,7 +59,8 @@ class diagnostic_helper {
 // A DiagnosticStream remembers the current position of the input and an error
 // code, and captures diagnostic messages via the left-shift operator.
 // If the error code is not SPV_FAILED_MATCH, then captured messages are
-// emitted during the destructor.
+// emitted during the destructor.  Otherwise, or if there is nowhere to emit
+// them, messages are not formatted at all.
 // TODO(awoloszyn): This is very similar to diagnostic_helper, and hides
 //                  the data more easily. Replace diagnostic_helper elsewhere
 //                  eventually.
@@ -66,25 +68,26 @@ class DiagnosticStream {
  public:
   DiagnosticStream(spv_position_t position, spv_diagnostic* pDiagnostic,
                    spv_result_t error)
-      : position_(position), pDiagnostic_(pDiagnostic), error_(error) {}
-
+      : stream_(pDiagnostic && error != SPV_FAILED_MATCH
+                    ? new std::ostringstream
+                    : nullptr),
+        position_(position),
+        pDiagnostic_(pDiagnostic),
+        error_(error) {}
+
+  // Takes over the message of the other object, which will then emit nothing.
   DiagnosticStream(DiagnosticStream&& other)
-      : stream_(other.stream_.str()),
+      : stream_(std::move(other.stream_)),
         position_(other.position_),
         pDiagnostic_(other.pDiagnostic_),
-        error_(other.error_) {
-    // The other object's destructor will emit the text in its stream_
-    // member if its pDiagnostic_ member is non-null.  Prevent that,
-    // since emitting that text is now the responsibility of *this.
-    other.pDiagnostic_ = nullptr;
-  }
+        error_(other.error_) {}
 
   ~DiagnosticStream();
 
   // Adds the given value to the diagnostic message to be written.
   template <typename T>
   DiagnosticStream& operator<<(const T& val) {
-    stream_ << val;
+    if (stream_) *stream_ << val;
     return *this;
   }
 
@@ -92,7 +95,8 @@ class DiagnosticStream {
   operator spv_result_t() { return error_; }
 
  private:
-  std::stringstream stream_;
+  // The message, or null if it would not be emitted.
+  std::unique_ptr<std::ostringstream> stream_;
   spv_position_t position_;
   spv_diagnostic* pDiagnostic_;
   spv_result_t error_;
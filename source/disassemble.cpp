@@ -28,7 +28,11 @@
 // to text.
 
 #include <cassert>
+#include <cmath>
 #include <cstring>
+#include <ostream>
+#include <streambuf>
+#include <string>
 #include <unordered_map>
 
 #include "assembly_grammar.h"
@@ -41,24 +45,96 @@
 #include "spirv_constant.h"
 #include "spirv_endian.h"
 #include "util/hex_float.h"
+#include "util/number_format.h"
 
 namespace {
 
+// A stream buffer that passes the text written to it to a write callback, in
+// chunks of bounded size.
+class WriteCallbackStreamBuf : public std::streambuf {
+ public:
+  WriteCallbackStreamBuf(void* user_data, spv_text_write_fn_t write_fn)
+      : user_data_(user_data), write_fn_(write_fn), error_(SPV_SUCCESS) {
+    setp(buffer_, buffer_ + kChunkSize);
+  }
+
+  // Passes any buffered text to the callback.  Returns the first status code
+  // other than SPV_SUCCESS returned by the callback, if any.
+  spv_result_t Flush() {
+    if (error_ == SPV_SUCCESS && pptr() != pbase()) {
+      error_ = write_fn_(user_data_, pbase(), size_t(pptr() - pbase()));
+    }
+    // After a failure, discard any further text.
+    setp(buffer_, buffer_ + kChunkSize);
+    return error_;
+  }
+
+  // Returns the first status code other than SPV_SUCCESS returned by the
+  // callback, or SPV_SUCCESS.
+  spv_result_t error() const { return error_; }
+
+ protected:
+  int_type overflow(int_type c) override {
+    Flush();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+    return traits_type::not_eof(c);
+  }
+
+  int sync() override { return Flush() == SPV_SUCCESS ? 0 : -1; }
+
+ private:
+  enum { kChunkSize = 16384 };
+
+  void* const user_data_;
+  const spv_text_write_fn_t write_fn_;
+  spv_result_t error_;
+  char buffer_[kChunkSize];
+};
+
+// The destination of spvBinaryToTextBuffer: a caller's buffer, and the length
+// of the text passed to WriteToTextBuffer so far.
+struct TextBuffer {
+  char* text;
+  size_t capacity;
+  size_t length;
+};
+
+// A spv_text_write_fn_t which copies text into the TextBuffer given as
+// user_data, as far as it fits, and counts its length.
+spv_result_t WriteToTextBuffer(void* user_data, const char* text,
+                               size_t length) {
+  auto buffer = static_cast<TextBuffer*>(user_data);
+  if (buffer->length + length <= buffer->capacity) {
+    memcpy(buffer->text + buffer->length, text, length);
+  }
+  buffer->length += length;
+  return SPV_SUCCESS;
+}
+
 // A Disassembler instance converts a SPIR-V binary to its assembly
 // representation.
 class Disassembler {
  public:
-  Disassembler(const libspirv::AssemblyGrammar& grammar,
-               uint32_t options)
+  // Creates a disassembler.  If sink is not null, the text is written to it
+  // rather than being printed or saved.
+  Disassembler(const libspirv::AssemblyGrammar& grammar, uint32_t options,
+               WriteCallbackStreamBuf* sink = nullptr)
       : grammar_(grammar),
-        print_(spvIsInBitfield(SPV_BINARY_TO_TEXT_OPTION_PRINT, options)),
+        print_(!sink &&
+               spvIsInBitfield(SPV_BINARY_TO_TEXT_OPTION_PRINT, options)),
         color_(print_ &&
                spvIsInBitfield(SPV_BINARY_TO_TEXT_OPTION_COLOR, options)),
         indent_(spvIsInBitfield(SPV_BINARY_TO_TEXT_OPTION_INDENT, options)
                     ? kStandardIndent
                     : 0),
+        sink_(sink),
         text_(),
-        out_(print_ ? out_stream() : out_stream(text_)),
+        sink_stream_(sink),
+        out_(print_ ? out_stream()
+                    : sink ? out_stream(sink_stream_) : out_stream(text_)),
         stream_(out_.get()) {}
 
   // Emits the assembly header for the module, and sets up internal state
@@ -74,6 +150,10 @@ class Disassembler {
   // Returns SPV_SUCCESS on success.
   spv_result_t SaveTextResult(spv_text* text_result) const;
 
+  // If writing to a sink, passes any remaining text to it.  Returns the
+  // first failure reported by the sink's callback, or SPV_SUCCESS.
+  spv_result_t FlushSink() { return sink_ ? sink_->Flush() : SPV_SUCCESS; }
+
  private:
   enum { kStandardIndent = 15 };
 
@@ -89,27 +169,51 @@ class Disassembler {
 
   // Resets the output color, if color is turned on.
   void ResetColor() {
-    if (color_) out_.get() << libspirv::clr::reset();
+    if (color_) FlushLine() << libspirv::clr::reset();
   }
   // Sets the output to grey, if color is turned on.
   void SetGrey() {
-    if (color_) out_.get() << libspirv::clr::grey();
+    if (color_) FlushLine() << libspirv::clr::grey();
   }
   // Sets the output to blue, if color is turned on.
   void SetBlue() {
-    if (color_) out_.get() << libspirv::clr::blue();
+    if (color_) FlushLine() << libspirv::clr::blue();
   }
   // Sets the output to yellow, if color is turned on.
   void SetYellow() {
-    if (color_) out_.get() << libspirv::clr::yellow();
+    if (color_) FlushLine() << libspirv::clr::yellow();
   }
   // Sets the output to red, if color is turned on.
   void SetRed() {
-    if (color_) out_.get() << libspirv::clr::red();
+    if (color_) FlushLine() << libspirv::clr::red();
   }
   // Sets the output to green, if color is turned on.
   void SetGreen() {
-    if (color_) out_.get() << libspirv::clr::green();
+    if (color_) FlushLine() << libspirv::clr::green();
+  }
+
+  // Appends text to the pending line.
+  void Append(const char* text) { line_.append(text); }
+  void Append(char c) { line_.push_back(c); }
+  // Appends the decimal representation of a number to the pending line.
+  void AppendUnsigned(uint64_t value) {
+    char buffer[spvutils::kNumberFormatBufferSize];
+    line_.append(buffer, spvutils::FormatUnsigned(value, buffer));
+  }
+  void AppendSigned(int64_t value) {
+    char buffer[spvutils::kNumberFormatBufferSize];
+    line_.append(buffer, spvutils::FormatSigned(value, buffer));
+  }
+  // Appends a floating point literal to the pending line.  Formats it like
+  // operator<< for spvutils::FloatProxy<T>.
+  template <typename T>
+  void AppendFloat(const spvutils::FloatProxy<T>& value);
+
+  // Writes the pending line to the output stream, and returns the stream.
+  std::ostream& FlushLine() {
+    stream_.write(line_.data(), std::streamsize(line_.size()));
+    line_.clear();
+    return stream_;
   }
 
   const libspirv::AssemblyGrammar& grammar_;
@@ -117,9 +221,16 @@ class Disassembler {
   const bool color_;  // Should we print in colour?
   const int indent_;  // How much to indent. 0 means don't indent
   spv_endianness_t endian_;  // The detected endianness of the binary.
-  std::stringstream text_;   // Captures the text, if not printing.
-  out_stream out_;  // The Output stream.  Either to text_ or standard output.
+  WriteCallbackStreamBuf* const sink_;  // Receives the text, if not null.
+  std::stringstream text_;  // Captures the text, if not printing or streaming.
+  std::ostream sink_stream_;  // Writes to sink_, if streaming.
+  // The Output stream.  Either to text_, sink_stream_ or standard output.
+  out_stream out_;
   std::ostream& stream_;  // The output std::stream.
+  // The text of the instruction being disassembled, not yet written to
+  // stream_.  Formatting into a plain buffer is much cheaper than going
+  // through the stream for each token.
+  std::string line_;
 };
 
 spv_result_t Disassembler::HandleHeader(spv_endianness_t endian,
@@ -145,7 +256,7 @@ spv_result_t Disassembler::HandleHeader(spv_endianness_t endian,
           << "; Schema: " << schema << "\n";
   ResetColor();
 
-  return SPV_SUCCESS;
+  return sink_ ? sink_->error() : SPV_SUCCESS;
 }
 
 // Returns the number of digits in n.
@@ -167,26 +278,33 @@ spv_result_t Disassembler::HandleInstruction(
   if (inst.result_id) {
     SetBlue();
     // Indent if needed, but account for the 4 characters in "%" and " = "
-    if (indent_) stream_ << std::setw(indent_ - 4 - NumDigits(inst.result_id));
-    stream_ << "%" << inst.result_id;
+    if (indent_) {
+      const int width = indent_ - 4 - NumDigits(inst.result_id);
+      if (width > 1) line_.append(size_t(width - 1), ' ');
+    }
+    Append('%');
+    AppendUnsigned(inst.result_id);
     ResetColor();
-    stream_ << " = ";
+    Append(" = ");
   } else {
-    stream_ << std::string(indent_, ' ');
+    line_.append(size_t(indent_), ' ');
   }
 
-  stream_ << "Op" << spvOpcodeString(inst.opcode);
+  Append("Op");
+  Append(spvOpcodeString(inst.opcode));
 
   for (uint16_t i = 0; i < inst.num_operands; i++) {
     const spv_operand_type_t type = inst.operands[i].type;
     assert(type != SPV_OPERAND_TYPE_NONE);
     if (type == SPV_OPERAND_TYPE_RESULT_ID) continue;
-    stream_ << " ";
+    Append(' ');
     EmitOperand(inst, i);
   }
 
-  stream_ << "\n";
-  return SPV_SUCCESS;
+  Append('\n');
+  FlushLine();
+  // Stop as soon as the sink fails.
+  return sink_ ? sink_->error() : SPV_SUCCESS;
 }
 
 void Disassembler::EmitOperand(const spv_parsed_instruction_t& inst,
@@ -198,28 +316,30 @@ void Disassembler::EmitOperand(const spv_parsed_instruction_t& inst,
     case SPV_OPERAND_TYPE_RESULT_ID:
       assert(false && "<result-id> is not supposed to be handled here");
       SetBlue();
-      stream_ << "%" << word;
+      Append('%');
+      AppendUnsigned(word);
       break;
     case SPV_OPERAND_TYPE_ID:
     case SPV_OPERAND_TYPE_TYPE_ID:
     case SPV_OPERAND_TYPE_SCOPE_ID:
     case SPV_OPERAND_TYPE_MEMORY_SEMANTICS_ID:
       SetYellow();
-      stream_ << "%" << word;
+      Append('%');
+      AppendUnsigned(word);
       break;
     case SPV_OPERAND_TYPE_EXTENSION_INSTRUCTION_NUMBER: {
       spv_ext_inst_desc ext_inst;
       if (grammar_.lookupExtInst(inst.ext_inst_type, word, &ext_inst))
         assert(false && "should have caught this earlier");
       SetRed();
-      stream_ << ext_inst->name;
+      Append(ext_inst->name);
     } break;
     case SPV_OPERAND_TYPE_SPEC_CONSTANT_OP_NUMBER: {
       spv_opcode_desc opcode_desc;
       if (grammar_.lookupOpcode(SpvOp(word), &opcode_desc))
         assert(false && "should have caught this earlier");
       SetRed();
-      stream_ << opcode_desc->name;
+      Append(opcode_desc->name);
     } break;
     case SPV_OPERAND_TYPE_LITERAL_INTEGER:
     case SPV_OPERAND_TYPE_TYPED_LITERAL_NUMBER: {
@@ -227,15 +347,15 @@ void Disassembler::EmitOperand(const spv_parsed_instruction_t& inst,
       if (operand.num_words == 1) {
         switch (operand.number_kind) {
           case SPV_NUMBER_SIGNED_INT:
-            stream_ << int32_t(word);
+            AppendSigned(int32_t(word));
             break;
           case SPV_NUMBER_UNSIGNED_INT:
-            stream_ << word;
+            AppendUnsigned(word);
             break;
           case SPV_NUMBER_FLOATING:
             // Assume only 32-bit floats.
             // TODO(dneto): Handle 16-bit floats also.
-            stream_ << spvutils::FloatProxy<float>(word);
+            AppendFloat(spvutils::FloatProxy<float>(word));
             break;
           default:
             assert(false && "Unreachable");
@@ -246,14 +366,14 @@ void Disassembler::EmitOperand(const spv_parsed_instruction_t& inst,
             uint64_t(word) | (uint64_t(inst.words[operand.offset + 1]) << 32);
         switch (operand.number_kind) {
           case SPV_NUMBER_SIGNED_INT:
-            stream_ << int64_t(bits);
+            AppendSigned(int64_t(bits));
             break;
           case SPV_NUMBER_UNSIGNED_INT:
-            stream_ << bits;
+            AppendUnsigned(bits);
             break;
           case SPV_NUMBER_FLOATING:
             // Assume only 64-bit floats.
-            stream_ << spvutils::FloatProxy<double>(bits);
+            AppendFloat(spvutils::FloatProxy<double>(bits));
             break;
           default:
             assert(false && "Unreachable");
@@ -264,18 +384,18 @@ void Disassembler::EmitOperand(const spv_parsed_instruction_t& inst,
       }
     } break;
     case SPV_OPERAND_TYPE_LITERAL_STRING: {
-      stream_ << "\"";
+      Append('"');
       SetGreen();
       // Strings are always little-endian, and null-terminated.
       // Write out the characters, escaping as needed, and without copying
       // the entire string.
       auto c_str = reinterpret_cast<const char*>(inst.words + operand.offset);
       for (auto p = c_str; *p; ++p) {
-        if (*p == '"' || *p == '\\') stream_ << '\\';
-        stream_ << *p;
+        if (*p == '"' || *p == '\\') Append('\\');
+        Append(*p);
       }
       ResetColor();
-      stream_ << '"';
+      Append('"');
     } break;
     case SPV_OPERAND_TYPE_CAPABILITY:
     case SPV_OPERAND_TYPE_SOURCE_LANGUAGE:
@@ -300,7 +420,7 @@ void Disassembler::EmitOperand(const spv_parsed_instruction_t& inst,
       spv_operand_desc entry;
       if (grammar_.lookupOperand(operand.type, word, &entry))
         assert(false && "should have caught this earlier");
-      stream_ << entry->name;
+      Append(entry->name);
     } break;
     case SPV_OPERAND_TYPE_FP_FAST_MATH_MODE:
     case SPV_OPERAND_TYPE_FUNCTION_CONTROL:
@@ -329,8 +449,8 @@ void Disassembler::EmitMaskOperand(const spv_operand_type_t type,
       spv_operand_desc entry;
       if (grammar_.lookupOperand(type, mask, &entry))
         assert(false && "should have caught this earlier");
-      if (num_emitted) stream_ << "|";
-      stream_ << entry->name;
+      if (num_emitted) Append('|');
+      Append(entry->name);
       num_emitted++;
     }
   }
@@ -339,7 +459,24 @@ void Disassembler::EmitMaskOperand(const spv_operand_type_t type,
     // of the 0 value. In many cases, that's "None".
     spv_operand_desc entry;
     if (SPV_SUCCESS == grammar_.lookupOperand(type, 0, &entry))
-      stream_ << entry->name;
+      Append(entry->name);
+  }
+}
+
+template <typename T>
+void Disassembler::AppendFloat(const spvutils::FloatProxy<T>& value) {
+  const T float_val = value.getAsFloat();
+  switch (std::fpclassify(float_val)) {
+    case FP_ZERO:
+    case FP_NORMAL: {
+      char buffer[spvutils::kNumberFormatBufferSize];
+      line_.append(buffer, spvutils::FormatDecimalFloat(float_val, buffer));
+    } break;
+    default:
+      // Subnormals, infinities and NaNs are rare, and are printed as hex
+      // floats.
+      FlushLine() << spvutils::HexFloat<spvutils::FloatProxy<T>>(value);
+      break;
   }
 }
 
@@ -399,3 +536,46 @@ spv_result_t spvBinaryToText(const spv_const_context context,
 
   return disassembler.SaveTextResult(pText);
 }
+
+spv_result_t spvBinaryToTextStream(const spv_const_context context,
+                                   const uint32_t* code,
+                                   const size_t wordCount,
+                                   const uint32_t options, void* user_data,
+                                   spv_text_write_fn_t write_fn,
+                                   spv_diagnostic* pDiagnostic) {
+  if (!pDiagnostic) return SPV_ERROR_INVALID_DIAGNOSTIC;
+  if (!write_fn) return SPV_ERROR_INVALID_POINTER;
+  const libspirv::AssemblyGrammar grammar(context);
+  if (!grammar.isValid()) return SPV_ERROR_INVALID_TABLE;
+
+  WriteCallbackStreamBuf sink(user_data, write_fn);
+  Disassembler disassembler(grammar, options, &sink);
+  if (auto error = spvBinaryParse(context, &disassembler, code, wordCount,
+                                  DisassembleHeader, DisassembleInstruction,
+                                  pDiagnostic)) {
+    return error;
+  }
+
+  return disassembler.FlushSink();
+}
+
+spv_result_t spvBinaryToTextBuffer(const spv_const_context context,
+                                   const uint32_t* code,
+                                   const size_t wordCount,
+                                   const uint32_t options, char* text,
+                                   const size_t capacity, size_t* length,
+                                   spv_diagnostic* pDiagnostic) {
+  if (!length || (!text && capacity)) return SPV_ERROR_INVALID_POINTER;
+
+  TextBuffer buffer = {text, capacity, 0};
+  if (auto error = spvBinaryToTextStream(context, code, wordCount, options,
+                                         &buffer, WriteToTextBuffer,
+                                         pDiagnostic)) {
+    return error;
+  }
+
+  *length = buffer.length;
+  if (buffer.length >= capacity) return SPV_ERROR_BUFFER_TOO_SMALL;
+  text[buffer.length] = 0;
+  return SPV_SUCCESS;
+}
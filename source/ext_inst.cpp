@@ -181,17 +181,19 @@ spv_ext_inst_type_t spvExtInstImportTypeGet(const char* name) {
 
 spv_result_t spvExtInstTableNameLookup(const spv_ext_inst_table table,
                                        const spv_ext_inst_type_t type,
-                                       const char* name,
+                                       const char* name, size_t name_len,
                                        spv_ext_inst_desc* pEntry) {
   if (!table) return SPV_ERROR_INVALID_TABLE;
-  if (!pEntry) return SPV_ERROR_INVALID_POINTER;
+  if (!name || !pEntry) return SPV_ERROR_INVALID_POINTER;
 
   for (uint32_t groupIndex = 0; groupIndex < table->count; groupIndex++) {
     auto& group = table->groups[groupIndex];
     if (type == group.type) {
       for (uint32_t index = 0; index < group.count; index++) {
         auto& entry = group.entries[index];
-        if (!strcmp(name, entry.name)) {
+        // The name may contain null characters, so compare lengths first.
+        if (strlen(entry.name) == name_len &&
+            !memcmp(entry.name, name, name_len)) {
           *pEntry = &table->groups[groupIndex].entries[index];
           return SPV_SUCCESS;
         }
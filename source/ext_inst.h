@@ -33,12 +33,13 @@
 // Gets the type of the extended instruction set with the specified name.
 spv_ext_inst_type_t spvExtInstImportTypeGet(const char* name);
 
-// Finds the named extented instruction of the given type in the given extended
-// instruction table. On success, returns SPV_SUCCESS and writes a handle of
-// the instruction entry into *entry.
+// Finds the extented instruction of the given type named by the name_len
+// characters at name in the given extended instruction table. On success,
+// returns SPV_SUCCESS and writes a handle of the instruction entry into
+// *entry.
 spv_result_t spvExtInstTableNameLookup(const spv_ext_inst_table table,
                                        const spv_ext_inst_type_t type,
-                                       const char* name,
+                                       const char* name, size_t name_len,
                                        spv_ext_inst_desc* entry);
 
 // Finds the extented instruction of the given type in the given extended
@@ -27,6 +27,7 @@
 #ifndef LIBSPIRV_INSTRUCTION_H_
 #define LIBSPIRV_INSTRUCTION_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -54,6 +55,33 @@ struct spv_instruction_t {
   std::vector<uint32_t> words;
 };
 
+// A read-only view of a sequence of words owned by someone else.  It offers
+// the parts of the std::vector interface used to inspect the words of an
+// instruction, so code can work with either representation.
+class spv_word_view_t {
+ public:
+  spv_word_view_t() : words_(nullptr), size_(0) {}
+  spv_word_view_t(const uint32_t* words, size_t size)
+      : words_(words), size_(size) {}
+
+  const uint32_t* data() const { return words_; }
+  size_t size() const { return size_; }
+  const uint32_t& operator[](size_t index) const { return words_[index]; }
+  const uint32_t* begin() const { return words_; }
+  const uint32_t* end() const { return words_ + size_; }
+
+ private:
+  const uint32_t* words_;
+  size_t size_;
+};
+
+// Describes an instruction of a binary module without copying it.  The words
+// are in host byte order, and are owned by the module.
+struct spv_instruction_view_t {
+  SpvOp opcode;
+  spv_word_view_t words;
+};
+
 // Appends a word to an instruction, without checking for overflow.
 inline void spvInstructionAddWord(spv_instruction_t* inst, uint32_t value) {
   inst->words.push_back(value);
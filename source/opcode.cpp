@@ -29,7 +29,9 @@
 #include <assert.h>
 #include <string.h>
 
+#include <algorithm>
 #include <cstdlib>
+#include <limits>
 
 #include "instruction.h"
 #include "libspirv/libspirv.h"
@@ -331,21 +333,61 @@ void spvOpcodeSplit(const uint32_t word, uint16_t* pWordCount, SpvOp* pOpcode) {
   }
 }
 
-spv_result_t spvOpcodeTableGet(spv_opcode_table* pInstTable) {
-  if (!pInstTable) return SPV_ERROR_INVALID_POINTER;
+namespace {
 
+// Builds the opcode table and its lookup indices.  The result is never freed.
+const spv_opcode_table_t* BuildOpcodeTable() {
   const uint32_t size = sizeof(opcodeTableEntries);
   spv_opcode_desc_t* copied_entries =
       static_cast<spv_opcode_desc_t*>(::malloc(size));
-  if (!copied_entries) return SPV_ERROR_OUT_OF_MEMORY;
+  if (!copied_entries) return nullptr;
   ::memcpy(copied_entries, opcodeTableEntries, size);
 
   const uint32_t count = static_cast<uint32_t>(sizeof(opcodeTableEntries) /
                                                sizeof(spv_opcode_desc_t));
-  spv_opcode_table_t* table = new spv_opcode_table_t{count, copied_entries};
+  static_assert(sizeof(opcodeTableEntries) / sizeof(spv_opcode_desc_t) <
+                    std::numeric_limits<uint16_t>::max(),
+                "Opcode table is too large to be indexed by uint16_t");
+
+  // Build the dense index keyed by opcode value.
+  uint32_t value_index_count = 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    value_index_count = std::max(value_index_count,
+                                 uint32_t(copied_entries[i].opcode) + 1);
+  }
+  uint16_t* value_index = new uint16_t[value_index_count];
+  std::fill(value_index, value_index + value_index_count, uint16_t(count));
+  for (uint32_t i = 0; i < count; ++i) {
+    // Keep the first entry for an opcode, as the linear scan used to.
+    uint16_t& slot = value_index[copied_entries[i].opcode];
+    if (slot == count) slot = uint16_t(i);
+  }
+
+  // Build the index sorted by name, for binary search.
+  uint16_t* name_index = new uint16_t[count];
+  for (uint32_t i = 0; i < count; ++i) name_index[i] = uint16_t(i);
+  std::stable_sort(name_index, name_index + count,
+                   [copied_entries](uint16_t lhs, uint16_t rhs) {
+                     return strcmp(copied_entries[lhs].name,
+                                   copied_entries[rhs].name) < 0;
+                   });
 
   spvOpcodeTableInitialize(copied_entries, count);
 
+  return new spv_opcode_table_t{count, copied_entries, value_index_count,
+                                value_index, name_index};
+}
+
+}  // anonymous namespace
+
+spv_result_t spvOpcodeTableGet(spv_opcode_table* pInstTable) {
+  if (!pInstTable) return SPV_ERROR_INVALID_POINTER;
+
+  // The table is immutable, so it is built once, on first use, and shared by
+  // all callers.  Initialization of a function-local static is thread safe.
+  static const spv_opcode_table_t* const table = BuildOpcodeTable();
+  if (!table) return SPV_ERROR_OUT_OF_MEMORY;
+
   *pInstTable = table;
 
   return SPV_SUCCESS;
@@ -354,24 +396,36 @@ spv_result_t spvOpcodeTableGet(spv_opcode_table* pInstTable) {
 spv_result_t spvOpcodeTableNameLookup(const spv_opcode_table table,
                                       const char* name,
                                       spv_opcode_desc* pEntry) {
+  if (!name) return SPV_ERROR_INVALID_POINTER;
+  return spvOpcodeTableNameLookup(table, name, strlen(name), pEntry);
+}
+
+spv_result_t spvOpcodeTableNameLookup(const spv_opcode_table table,
+                                      const char* name, size_t name_len,
+                                      spv_opcode_desc* pEntry) {
   if (!name || !pEntry) return SPV_ERROR_INVALID_POINTER;
   if (!table) return SPV_ERROR_INVALID_TABLE;
 
-  // TODO: This lookup of the Opcode table is suboptimal! Binary sort would be
-  // preferable but the table requires sorting on the Opcode name, but it's
-  // static
-  // const initialized and matches the order of the spec.
-  const size_t nameLength = strlen(name);
-  for (uint64_t opcodeIndex = 0; opcodeIndex < table->count; ++opcodeIndex) {
-    if (nameLength == strlen(table->entries[opcodeIndex].name) &&
-        !strncmp(name, table->entries[opcodeIndex].name, nameLength)) {
-      // NOTE: Found out Opcode!
-      *pEntry = &table->entries[opcodeIndex];
-      return SPV_SUCCESS;
-    }
-  }
-
-  return SPV_ERROR_INVALID_LOOKUP;
+  // Orders a null-terminated entry name against the key, which is not
+  // null-terminated and may contain null characters.
+  auto compare = [name, name_len](const char* entry_name) {
+    const size_t entry_len = strlen(entry_name);
+    if (int result = memcmp(entry_name, name, std::min(entry_len, name_len)))
+      return result;
+    return entry_len < name_len ? -1 : entry_len > name_len ? 1 : 0;
+  };
+  const spv_opcode_desc_t* entries = table->entries;
+  const uint16_t* first = table->name_index;
+  const uint16_t* last = first + table->count;
+  const uint16_t* found = std::lower_bound(
+      first, last, name, [entries, &compare](uint16_t index, const char*) {
+        return compare(entries[index].name) < 0;
+      });
+  if (found == last || compare(entries[*found].name))
+    return SPV_ERROR_INVALID_LOOKUP;
+
+  *pEntry = &entries[*found];
+  return SPV_SUCCESS;
 }
 
 spv_result_t spvOpcodeTableValueLookup(const spv_opcode_table table,
@@ -380,39 +434,19 @@ spv_result_t spvOpcodeTableValueLookup(const spv_opcode_table table,
   if (!table) return SPV_ERROR_INVALID_TABLE;
   if (!pEntry) return SPV_ERROR_INVALID_POINTER;
 
-  // TODO: As above this lookup is not optimal.
-  for (uint64_t opcodeIndex = 0; opcodeIndex < table->count; ++opcodeIndex) {
-    if (opcode == table->entries[opcodeIndex].opcode) {
-      // NOTE: Found the Opcode!
-      *pEntry = &table->entries[opcodeIndex];
-      return SPV_SUCCESS;
-    }
-  }
+  const uint32_t value = uint32_t(opcode);
+  if (value >= table->value_index_count) return SPV_ERROR_INVALID_LOOKUP;
+  const uint16_t index = table->value_index[value];
+  if (index == table->count) return SPV_ERROR_INVALID_LOOKUP;
 
-  return SPV_ERROR_INVALID_LOOKUP;
+  *pEntry = &table->entries[index];
+  return SPV_SUCCESS;
 }
 
 int32_t spvOpcodeRequiresCapabilities(spv_opcode_desc entry) {
   return entry->capabilities != 0;
 }
 
-void spvInstructionCopy(const uint32_t* words, const SpvOp opcode,
-                        const uint16_t wordCount, const spv_endianness_t endian,
-                        spv_instruction_t* pInst) {
-  pInst->opcode = opcode;
-  pInst->words.resize(wordCount);
-  for (uint16_t wordIndex = 0; wordIndex < wordCount; ++wordIndex) {
-    pInst->words[wordIndex] = spvFixWord(words[wordIndex], endian);
-    if (!wordIndex) {
-      uint16_t thisWordCount;
-      SpvOp thisOpcode;
-      spvOpcodeSplit(pInst->words[wordIndex], &thisWordCount, &thisOpcode);
-      assert(opcode == thisOpcode && wordCount == thisWordCount &&
-             "Endianness failed!");
-    }
-  }
-}
-
 const char* spvOpcodeString(const SpvOp opcode) {
 // Use the syntax table so it's sure to be complete.
 #define Instruction(Name, ...) \
@@ -469,8 +503,8 @@ int32_t spvOpcodeIsComposite(const SpvOp opcode) {
   }
 }
 
-int32_t spvOpcodeAreTypesEqual(const spv_instruction_t* pTypeInst0,
-                               const spv_instruction_t* pTypeInst1) {
+int32_t spvOpcodeAreTypesEqual(const spv_instruction_view_t* pTypeInst0,
+                               const spv_instruction_view_t* pTypeInst1) {
   if (pTypeInst0->opcode != pTypeInst1->opcode) return false;
   if (pTypeInst0->words[1] != pTypeInst1->words[1]) return false;
   return true;
@@ -619,8 +653,8 @@ int32_t spvOpcodeIsBasicTypeNullable(SpvOp opcode) {
   }
 }
 
-int32_t spvInstructionIsInBasicBlock(const spv_instruction_t* pFirstInst,
-                                     const spv_instruction_t* pInst) {
+int32_t spvInstructionIsInBasicBlock(const spv_instruction_view_t* pFirstInst,
+                                     const spv_instruction_view_t* pInst) {
   while (pFirstInst != pInst) {
     if (SpvOpFunction == pInst->opcode) break;
     pInst--;
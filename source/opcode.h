@@ -50,6 +50,13 @@ void spvOpcodeSplit(const uint32_t word, uint16_t* word_count, SpvOp* opcode);
 spv_result_t spvOpcodeTableNameLookup(const spv_opcode_table table,
                                       const char* name, spv_opcode_desc* entry);
 
+// Finds the opcode named by the name_len characters at name in the given
+// opcode table. On success, returns SPV_SUCCESS and writes a handle of the
+// table entry into *entry.
+spv_result_t spvOpcodeTableNameLookup(const spv_opcode_table table,
+                                      const char* name, size_t name_len,
+                                      spv_opcode_desc* entry);
+
 // Finds the opcode by enumerant in the given opcode table. On success, returns
 // SPV_SUCCESS and writes a handle of the table entry into *entry.
 spv_result_t spvOpcodeTableValueLookup(const spv_opcode_table table,
@@ -60,14 +67,6 @@ spv_result_t spvOpcodeTableValueLookup(const spv_opcode_table table,
 // non-zero otherwise. This function does not check if the given entry is valid.
 int32_t spvOpcodeRequiresCapabilities(spv_opcode_desc opcode);
 
-// Copies an instruction's word and fixes the endianness to host native. The
-// source instruction's stream/opcode/endianness is in the words/opcode/endian
-// parameter. The word_count parameter specifies the number of words to copy.
-// Writes copied instruction into *inst.
-void spvInstructionCopy(const uint32_t* words, const SpvOp opcode,
-                        const uint16_t word_count,
-                        const spv_endianness_t endian, spv_instruction_t* inst);
-
 // Gets the name of an instruction, without the "Op" prefix.
 const char* spvOpcodeString(const SpvOp opcode);
 
@@ -85,8 +84,8 @@ int32_t spvOpcodeIsComposite(const SpvOp opcode);
 
 // Deep equal comparison of type declaration instructions. Returns zero if
 // false, non-zero otherwise.
-int32_t spvOpcodeAreTypesEqual(const spv_instruction_t* type_inst0,
-                               const spv_instruction_t* type_inst1);
+int32_t spvOpcodeAreTypesEqual(const spv_instruction_view_t* type_inst0,
+                               const spv_instruction_view_t* type_inst1);
 
 // Determines if the given opcode results in a pointer. Returns zero if false,
 // non-zero otherwise.
@@ -103,8 +102,8 @@ int32_t spvOpcodeIsBasicTypeNullable(SpvOp opcode);
 // Determines if an instruction is in a basic block. The first_inst parameter
 // specifies the first instruction in the stream, while the inst parameter
 // specifies the current instruction. Returns zero if false, non-zero otherwise.
-int32_t spvInstructionIsInBasicBlock(const spv_instruction_t* first_inst,
-                                     const spv_instruction_t* inst);
+int32_t spvInstructionIsInBasicBlock(const spv_instruction_view_t* first_inst,
+                                     const spv_instruction_view_t* inst);
 
 // Determines if the given opcode contains a value. Returns zero if false,
 // non-zero otherwise.
@@ -29,6 +29,9 @@
 #include <assert.h>
 #include <string.h>
 
+#include <algorithm>
+#include <vector>
+
 static const spv_operand_desc_t sourceLanguageEntries[] = {
     {"Unknown", SpvSourceLanguageUnknown, 0, {SPV_OPERAND_TYPE_NONE}},
     {"ESSL", SpvSourceLanguageESSL, 0, {SPV_OPERAND_TYPE_NONE}},
@@ -1110,11 +1113,166 @@ static const spv_operand_desc_group_t opcodeEntryTypes[] = {
      capabilityInfoEntries},
 };
 
+namespace {
+
+// Returns the hash of an operand name of the given length, qualified by its
+// operand type.  This is the 32-bit FNV-1a hash.
+uint32_t HashOperandName(spv_operand_type_t type, const char* name,
+                         size_t name_length) {
+  uint32_t hash = 2166136261u ^ uint32_t(type);
+  for (size_t i = 0; i < name_length; ++i) {
+    hash ^= uint8_t(name[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Returns true if the null-terminated entry name is exactly the given name
+// of the given length.  The name may contain null characters, so the lengths
+// are compared before the characters.
+bool OperandNameMatches(const char* entry_name, const char* name,
+                        size_t name_length) {
+  return strlen(entry_name) == name_length &&
+         !memcmp(entry_name, name, name_length);
+}
+
+// Don't use a dense value index for a type unless at least this fraction
+// of its slots would be occupied.  Masks are usually sparse.
+const uint32_t kMaxDenseSlotsPerEntry = 4;
+
+}  // anonymous namespace
+
+struct spv_operand_table_index_t {
+  // Builds the index over the given table.  When several entries have the
+  // same type and name, or the same type and value, the first one wins, just
+  // as for a scan of the table.
+  explicit spv_operand_table_index_t(const spv_operand_table_t& table);
+
+  // Returns the entry with the given type and name, or nullptr.
+  spv_operand_desc findByName(spv_operand_type_t type, const char* name,
+                              size_t name_length) const;
+
+  // Returns the entry with the given type and value, or nullptr.
+  spv_operand_desc findByValue(spv_operand_type_t type, uint32_t value) const;
+
+ private:
+  // Value lookup for a single operand type.  Exactly one of the members is
+  // populated, depending on how dense the values of the type are.
+  struct ValueIndex {
+    // Entries indexed by value, with nullptr for unused values.
+    std::vector<spv_operand_desc> dense;
+    // Entries sorted by value.
+    std::vector<spv_operand_desc> sorted;
+  };
+
+  // A slot in the open-addressing hash table of names.
+  struct NameSlot {
+    uint32_t hash;
+    spv_operand_desc entry;  // nullptr for an empty slot.
+    spv_operand_type_t type;
+    size_t name_length;  // The length of the entry's name.
+  };
+
+  // Value indices, indexed by operand type.
+  ValueIndex values_[SPV_OPERAND_TYPE_NUM_OPERAND_TYPES];
+  // The hash table of names.  Its size is a power of two, and it is never
+  // more than half full.
+  std::vector<NameSlot> names_;
+};
+
+spv_operand_table_index_t::spv_operand_table_index_t(
+    const spv_operand_table_t& table) {
+  uint32_t num_entries = 0;
+  for (uint32_t i = 0; i < table.count; ++i) num_entries += table.types[i].count;
+  size_t num_slots = 16;
+  while (num_slots < 2 * size_t(num_entries)) num_slots *= 2;
+  names_.assign(num_slots, NameSlot{0, nullptr, SPV_OPERAND_TYPE_NONE, 0});
+
+  // Group the entries of each type in table order.
+  std::vector<spv_operand_desc> by_type[SPV_OPERAND_TYPE_NUM_OPERAND_TYPES];
+  for (uint32_t i = 0; i < table.count; ++i) {
+    const spv_operand_desc_group_t& group = table.types[i];
+    assert(group.type < SPV_OPERAND_TYPE_NUM_OPERAND_TYPES);
+    for (uint32_t j = 0; j < group.count; ++j) {
+      by_type[group.type].push_back(&group.entries[j]);
+    }
+  }
+
+  for (int type = 0; type < SPV_OPERAND_TYPE_NUM_OPERAND_TYPES; ++type) {
+    const std::vector<spv_operand_desc>& entries = by_type[type];
+    if (entries.empty()) continue;
+
+    ValueIndex& value_index = values_[type];
+    uint32_t max_value = 0;
+    for (auto entry : entries) max_value = std::max(max_value, entry->value);
+    if (max_value / kMaxDenseSlotsPerEntry < entries.size()) {
+      value_index.dense.assign(size_t(max_value) + 1, nullptr);
+      for (auto entry : entries) {
+        if (!value_index.dense[entry->value])
+          value_index.dense[entry->value] = entry;
+      }
+    } else {
+      value_index.sorted = entries;
+      std::stable_sort(value_index.sorted.begin(), value_index.sorted.end(),
+                       [](spv_operand_desc lhs, spv_operand_desc rhs) {
+                         return lhs->value < rhs->value;
+                       });
+    }
+
+    for (auto entry : entries) {
+      const size_t name_length = strlen(entry->name);
+      if (findByName(spv_operand_type_t(type), entry->name, name_length))
+        continue;
+      const uint32_t hash =
+          HashOperandName(spv_operand_type_t(type), entry->name, name_length);
+      size_t slot = hash & (names_.size() - 1);
+      while (names_[slot].entry) slot = (slot + 1) & (names_.size() - 1);
+      names_[slot] = {hash, entry, spv_operand_type_t(type), name_length};
+    }
+  }
+}
+
+spv_operand_desc spv_operand_table_index_t::findByName(
+    spv_operand_type_t type, const char* name, size_t name_length) const {
+  const uint32_t hash = HashOperandName(type, name, name_length);
+  for (size_t slot = hash & (names_.size() - 1); names_[slot].entry;
+       slot = (slot + 1) & (names_.size() - 1)) {
+    const NameSlot& candidate = names_[slot];
+    if (candidate.hash == hash && candidate.type == type &&
+        candidate.name_length == name_length &&
+        !memcmp(candidate.entry->name, name, name_length)) {
+      return candidate.entry;
+    }
+  }
+  return nullptr;
+}
+
+spv_operand_desc spv_operand_table_index_t::findByValue(
+    spv_operand_type_t type, uint32_t value) const {
+  if (uint32_t(type) >= SPV_OPERAND_TYPE_NUM_OPERAND_TYPES) return nullptr;
+  const ValueIndex& value_index = values_[type];
+  if (!value_index.dense.empty()) {
+    return value < value_index.dense.size() ? value_index.dense[value]
+                                            : nullptr;
+  }
+  auto found = std::lower_bound(
+      value_index.sorted.begin(), value_index.sorted.end(), value,
+      [](spv_operand_desc entry, uint32_t key) { return entry->value < key; });
+  if (found == value_index.sorted.end() || (*found)->value != value)
+    return nullptr;
+  return *found;
+}
+
 spv_result_t spvOperandTableGet(spv_operand_table* pOperandTable) {
   if (!pOperandTable) return SPV_ERROR_INVALID_POINTER;
 
+  static const spv_operand_table_t unindexed_table = {
+      ARRAY_SIZE(opcodeEntryTypes), opcodeEntryTypes, nullptr};
+  // The index is built once, on first use.  Initialization of a function-local
+  // static is thread safe.
+  static const spv_operand_table_index_t index(unindexed_table);
   static const spv_operand_table_t table = {ARRAY_SIZE(opcodeEntryTypes),
-                                            opcodeEntryTypes};
+                                            opcodeEntryTypes, &index};
 
   *pOperandTable = &table;
 
@@ -1131,14 +1289,20 @@ spv_result_t spvOperandTableNameLookup(const spv_operand_table table,
   if (!table) return SPV_ERROR_INVALID_TABLE;
   if (!name || !pEntry) return SPV_ERROR_INVALID_POINTER;
 
+  if (table->index) {
+    spv_operand_desc entry = table->index->findByName(type, name, nameLength);
+    if (!entry) return SPV_ERROR_INVALID_LOOKUP;
+    *pEntry = entry;
+    return SPV_SUCCESS;
+  }
+
   for (uint64_t typeIndex = 0; typeIndex < table->count; ++typeIndex) {
     if (type == table->types[typeIndex].type) {
       for (uint64_t operandIndex = 0;
            operandIndex < table->types[typeIndex].count; ++operandIndex) {
-        if (nameLength ==
-                strlen(table->types[typeIndex].entries[operandIndex].name) &&
-            !strncmp(table->types[typeIndex].entries[operandIndex].name, name,
-                     nameLength)) {
+        if (OperandNameMatches(
+                table->types[typeIndex].entries[operandIndex].name, name,
+                nameLength)) {
           *pEntry = &table->types[typeIndex].entries[operandIndex];
           return SPV_SUCCESS;
         }
@@ -1156,6 +1320,13 @@ spv_result_t spvOperandTableValueLookup(const spv_operand_table table,
   if (!table) return SPV_ERROR_INVALID_TABLE;
   if (!pEntry) return SPV_ERROR_INVALID_POINTER;
 
+  if (table->index) {
+    spv_operand_desc entry = table->index->findByValue(type, value);
+    if (!entry) return SPV_ERROR_INVALID_LOOKUP;
+    *pEntry = entry;
+    return SPV_SUCCESS;
+  }
+
   for (uint64_t typeIndex = 0; typeIndex < table->count; ++typeIndex) {
     if (type == table->types[typeIndex].type) {
       for (uint64_t operandIndex = 0;
@@ -36,7 +36,7 @@ namespace libspirv {
 class out_stream {
  public:
   out_stream() : pStream(nullptr) {}
-  out_stream(std::stringstream& stream) : pStream(&stream) {}
+  out_stream(std::ostream& stream) : pStream(&stream) {}
 
   std::ostream& get() {
     if (pStream) {
@@ -46,7 +46,7 @@ class out_stream {
   }
 
  private:
-  std::stringstream* pStream;
+  std::ostream* pStream;
 };
 
 namespace clr {
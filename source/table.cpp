@@ -26,8 +26,6 @@
 
 #include "table.h"
 
-#include <cstdlib>
-
 spv_context spvContextCreate() {
   spv_opcode_table opcode_table;
   spv_operand_table operand_table;
@@ -41,7 +39,6 @@ spv_context spvContextCreate() {
 }
 
 void spvContextDestroy(spv_context context) {
-  ::free(context->opcode_table->entries);
-  delete context->opcode_table;
+  // The grammar tables are shared by all contexts, and are never freed.
   delete context;
 }
@@ -77,11 +77,22 @@ typedef struct spv_ext_inst_group_t {
 typedef struct spv_opcode_table_t {
   const uint32_t count;
   spv_opcode_desc_t* entries;
+  // Maps an opcode value to the index of its entry, or to count if there is
+  // no such opcode.  Only opcode values less than value_index_count are mapped.
+  const uint32_t value_index_count;
+  const uint16_t* value_index;
+  // The indices of all entries, sorted by opcode name.
+  const uint16_t* name_index;
 } spv_opcode_table_t;
 
+// Lookup indices over the entries of an operand table.  Defined in operand.cpp.
+struct spv_operand_table_index_t;
+
 typedef struct spv_operand_table_t {
   const uint32_t count;
   const spv_operand_desc_group_t* types;
+  // Speeds up lookups by name and by value.  If null, lookups scan the table.
+  const spv_operand_table_index_t* index;
 } spv_operand_table_t;
 
 typedef struct spv_ext_inst_table_t {
@@ -103,6 +114,10 @@ struct spv_context_t {
   const spv_ext_inst_table ext_inst_table;
 };
 
+// Each of the following functions writes a handle to a grammar table into
+// *table.  The tables are immutable, built at most once per process, and
+// shared by all callers.  They must not be freed.
+
 // Populates the given opcode table.
 spv_result_t spvOpcodeTableGet(spv_opcode_table* table);
 
@@ -56,15 +56,14 @@ bool spvIsValidIDCharacter(const char value) {
 }
 
 // Returns true if the given string represents a valid ID name.
-bool spvIsValidID(const char* textValue) {
-  const char* c = textValue;
-  for (; *c != '\0'; ++c) {
-    if (!spvIsValidIDCharacter(*c)) {
+bool spvIsValidID(const libspirv::TextToken& textValue) {
+  for (size_t i = 0; i < textValue.size(); ++i) {
+    if (!spvIsValidIDCharacter(textValue[i])) {
       return false;
     }
   }
   // If the string was empty, then the ID also is not valid.
-  return c != textValue;
+  return !textValue.empty();
 }
 
 // Text API
@@ -168,15 +167,55 @@ namespace {
 /// and returns SPV_SUCCESS.  Otherwise, leaves pInst alone, emits diagnostics,
 /// and returns SPV_ERROR_INVALID_TEXT.
 spv_result_t encodeImmediate(libspirv::AssemblyContext* context,
-                             const char* text, spv_instruction_t* pInst) {
-  assert(*text == '!');
+                             const libspirv::TextToken& text,
+                             spv_instruction_t* pInst) {
+  assert(text.front() == '!');
   uint32_t parse_result;
-  if (auto error =
-          context->parseNumber(text + 1, SPV_ERROR_INVALID_TEXT, &parse_result,
-                               "Invalid immediate integer: !"))
+  if (auto error = context->parseNumber(text.substr(1), SPV_ERROR_INVALID_TEXT,
+                                        &parse_result,
+                                        "Invalid immediate integer: !"))
     return error;
   context->binaryEncodeU32(parse_result, pInst);
-  context->seekForward(static_cast<uint32_t>(strlen(text)));
+  context->seekForward(static_cast<uint32_t>(text.size()));
+  return SPV_SUCCESS;
+}
+
+/// Finds the contents of a literal string, which is surrounded by double
+/// quotes in the text.  If successful, *contents refers to the characters
+/// between the quotes, or to *unescaped if there were escape sequences to
+/// remove from them.  Returns SPV_FAILED_MATCH if the text is not quoted, and
+/// SPV_ERROR_OUT_OF_MEMORY if the string is too long.
+spv_result_t getLiteralString(const libspirv::TextToken& textValue,
+                              libspirv::TextToken* contents,
+                              std::string* unescaped) {
+  if (textValue.size() < 2 || textValue.front() != '"' ||
+      textValue.back() != '"') {
+    return SPV_FAILED_MATCH;
+  }
+
+  const libspirv::TextToken quoted(textValue.data() + 1, textValue.size() - 2);
+  if (!quoted.contains('\\')) {
+    // Have to save space for the null-terminator
+    if (quoted.size() > SPV_LIMIT_LITERAL_STRING_BYTES_MAX)
+      return SPV_ERROR_OUT_OF_MEMORY;
+    *contents = quoted;
+    return SPV_SUCCESS;
+  }
+
+  unescaped->clear();
+  bool escaping = false;
+  for (size_t i = 0; i < quoted.size(); ++i) {
+    if ((quoted[i] == '\\') && (!escaping)) {
+      escaping = true;
+    } else {
+      // Have to save space for the null-terminator
+      if (unescaped->size() >= SPV_LIMIT_LITERAL_STRING_BYTES_MAX)
+        return SPV_ERROR_OUT_OF_MEMORY;
+      unescaped->push_back(quoted[i]);
+      escaping = false;
+    }
+  }
+  *contents = libspirv::TextToken(unescaped->data(), unescaped->size());
   return SPV_SUCCESS;
 }
 
@@ -195,11 +234,11 @@ spv_result_t encodeImmediate(libspirv::AssemblyContext* context,
 spv_result_t spvTextEncodeOperand(const libspirv::AssemblyGrammar& grammar,
                                   libspirv::AssemblyContext* context,
                                   const spv_operand_type_t type,
-                                  const char* textValue,
+                                  const libspirv::TextToken& textValue,
                                   spv_instruction_t* pInst,
                                   spv_operand_pattern_t* pExpectedOperands) {
   // NOTE: Handle immediate int in the stream
-  if ('!' == textValue[0]) {
+  if ('!' == textValue.front()) {
     if (auto error = encodeImmediate(context, textValue, pInst)) {
       return error;
     }
@@ -221,15 +260,14 @@ spv_result_t spvTextEncodeOperand(const libspirv::AssemblyGrammar& grammar,
     case SPV_OPERAND_TYPE_MEMORY_SEMANTICS_ID:
     case SPV_OPERAND_TYPE_SCOPE_ID:
     case SPV_OPERAND_TYPE_OPTIONAL_ID: {
-      if ('%' == textValue[0]) {
-        textValue++;
-      } else {
+      if ('%' != textValue.front()) {
         return context->diagnostic() << "Expected id to start with %.";
       }
-      if (!spvIsValidID(textValue)) {
-        return context->diagnostic() << "Invalid ID " << textValue;
+      const libspirv::TextToken name = textValue.substr(1);
+      if (!spvIsValidID(name)) {
+        return context->diagnostic() << "Invalid ID " << name;
       }
-      const uint32_t id = context->spvNamedIdAssignOrGet(textValue);
+      const uint32_t id = context->spvNamedIdAssignOrGet(name);
       if (type == SPV_OPERAND_TYPE_TYPE_ID) pInst->resultTypeId = id;
       spvInstructionAddWord(pInst, id);
 
@@ -250,7 +288,8 @@ spv_result_t spvTextEncodeOperand(const libspirv::AssemblyGrammar& grammar,
       // The assembler accepts the symbolic name for an extended instruction,
       // and emits its corresponding number.
       spv_ext_inst_desc extInst;
-      if (grammar.lookupExtInst(pInst->extInstType, textValue, &extInst)) {
+      if (grammar.lookupExtInst(pInst->extInstType, textValue.data(),
+                                textValue.size(), &extInst)) {
         return context->diagnostic() << "Invalid extended instruction name '"
                                      << textValue << "'.";
       }
@@ -265,7 +304,8 @@ spv_result_t spvTextEncodeOperand(const libspirv::AssemblyGrammar& grammar,
       // the "Op" prefix.  For example, "IAdd" is accepted.  The number
       // of the opcode is emitted.
       SpvOp opcode;
-      if (grammar.lookupSpecConstantOpcode(textValue, &opcode)) {
+      if (grammar.lookupSpecConstantOpcode(textValue.data(), textValue.size(),
+                                           &opcode)) {
         return context->diagnostic() << "Invalid " << spvOperandTypeStr(type)
                                      << " '" << textValue << "'.";
       }
@@ -346,34 +386,37 @@ spv_result_t spvTextEncodeOperand(const libspirv::AssemblyGrammar& grammar,
 
     case SPV_OPERAND_TYPE_LITERAL_STRING:
     case SPV_OPERAND_TYPE_OPTIONAL_LITERAL_STRING: {
-      spv_literal_t literal = {};
-      spv_result_t error = spvTextToLiteral(textValue, &literal);
-      if (error != SPV_SUCCESS) {
-        if (error == SPV_ERROR_OUT_OF_MEMORY) return error;
+      // NOTE: The string is encoded straight from the text, unless escape
+      // sequences have to be removed from it first.
+      libspirv::TextToken literal;
+      std::string unescaped;
+      spv_result_t error = getLiteralString(textValue, &literal, &unescaped);
+      if (error == SPV_ERROR_OUT_OF_MEMORY) return error;
+      if (error) {
+        spv_literal_t number = {};
+        if (spvTextToLiteral(textValue.str().c_str(), &number) == SPV_SUCCESS) {
+          return context->diagnostic()
+                 << "Expected literal string, found literal number '"
+                 << textValue << "'.";
+        }
         return context->diagnostic(error_code_for_literals)
                << "Invalid literal string '" << textValue << "'.";
       }
-      if (literal.type != SPV_LITERAL_TYPE_STRING) {
-        return context->diagnostic()
-               << "Expected literal string, found literal number '" << textValue
-               << "'.";
-      }
 
       // NOTE: Special case for extended instruction library import
       if (SpvOpExtInstImport == pInst->opcode) {
         const spv_ext_inst_type_t ext_inst_type =
-            spvExtInstImportTypeGet(literal.str.c_str());
+            spvExtInstImportTypeGet(literal.str().c_str());
         if (SPV_EXT_INST_TYPE_NONE == ext_inst_type) {
           return context->diagnostic()
-                 << "Invalid extended instruction import '" << literal.str
-                 << "'";
+                 << "Invalid extended instruction import '" << literal << "'";
         }
         if ((error = context->recordIdAsExtInstImport(pInst->words[1],
                                                       ext_inst_type)))
           return error;
       }
 
-      if (context->binaryEncodeString(literal.str.c_str(), pInst))
+      if (context->binaryEncodeString(literal, pInst))
         return SPV_ERROR_INVALID_TEXT;
     } break;
     case SPV_OPERAND_TYPE_FP_FAST_MATH_MODE:
@@ -383,7 +426,8 @@ spv_result_t spvTextEncodeOperand(const libspirv::AssemblyGrammar& grammar,
     case SPV_OPERAND_TYPE_OPTIONAL_MEMORY_ACCESS:
     case SPV_OPERAND_TYPE_SELECTION_CONTROL: {
       uint32_t value;
-      if (grammar.parseMaskOperand(type, textValue, &value)) {
+      if (grammar.parseMaskOperand(type, textValue.data(), textValue.size(),
+                                   &value)) {
         return context->diagnostic() << "Invalid " << spvOperandTypeStr(type)
                                      << " operand '" << textValue << "'.";
       }
@@ -419,7 +463,8 @@ spv_result_t spvTextEncodeOperand(const libspirv::AssemblyGrammar& grammar,
       // NOTE: All non literal operands are handled here using the operand
       // table.
       spv_operand_desc entry;
-      if (grammar.lookupOperand(type, textValue, strlen(textValue), &entry)) {
+      if (grammar.lookupOperand(type, textValue.data(), textValue.size(),
+                                &entry)) {
         return context->diagnostic() << "Invalid " << spvOperandTypeStr(type)
                                      << " '" << textValue << "'.";
       }
@@ -445,12 +490,12 @@ namespace {
 spv_result_t encodeInstructionStartingWithImmediate(
     const libspirv::AssemblyGrammar& grammar,
     libspirv::AssemblyContext* context, spv_instruction_t* pInst) {
-  std::string firstWord;
+  libspirv::TextToken firstWord;
   spv_position_t nextPosition = {};
   auto error = context->getWord(firstWord, &nextPosition);
   if (error) return context->diagnostic(error) << "Internal Error";
 
-  if ((error = encodeImmediate(context, firstWord.c_str(), pInst))) {
+  if ((error = encodeImmediate(context, firstWord, pInst))) {
     return error;
   }
   while (context->advance() != SPV_END_OF_STREAM) {
@@ -459,7 +504,7 @@ spv_result_t encodeInstructionStartingWithImmediate(
 
     // Otherwise, there must be an operand that's either a literal, an ID, or
     // an immediate.
-    std::string operandValue;
+    libspirv::TextToken operandValue;
     if ((error = context->getWord(operandValue, &nextPosition)))
       return context->diagnostic(error) << "Internal Error";
 
@@ -469,9 +514,9 @@ spv_result_t encodeInstructionStartingWithImmediate(
     // Needed to pass to spvTextEncodeOpcode(), but it shouldn't ever be
     // expanded.
     spv_operand_pattern_t dummyExpectedOperands;
-    error = spvTextEncodeOperand(
-        grammar, context, SPV_OPERAND_TYPE_OPTIONAL_CIV, operandValue.c_str(),
-        pInst, &dummyExpectedOperands);
+    error = spvTextEncodeOperand(grammar, context,
+                                 SPV_OPERAND_TYPE_OPTIONAL_CIV, operandValue,
+                                 pInst, &dummyExpectedOperands);
     if (error) return error;
     context->setPosition(nextPosition);
   }
@@ -496,13 +541,13 @@ spv_result_t spvTextEncodeOpcode(const libspirv::AssemblyGrammar& grammar,
     return encodeInstructionStartingWithImmediate(grammar, context, pInst);
   }
 
-  std::string firstWord;
+  libspirv::TextToken firstWord;
   spv_position_t nextPosition = {};
   spv_result_t error = context->getWord(firstWord, &nextPosition);
   if (error) return context->diagnostic() << "Internal Error";
 
-  std::string opcodeName;
-  std::string result_id;
+  libspirv::TextToken opcodeName;
+  libspirv::TextToken result_id;
   spv_position_t result_id_position = {};
   if (context->startsWithOp()) {
     opcodeName = firstWord;
@@ -520,7 +565,7 @@ spv_result_t spvTextEncodeOpcode(const libspirv::AssemblyGrammar& grammar,
     context->setPosition(nextPosition);
     if (context->advance())
       return context->diagnostic() << "Expected '=', found end of stream.";
-    std::string equal_sign;
+    libspirv::TextToken equal_sign;
     error = context->getWord(equal_sign, &nextPosition);
     if ("=" != equal_sign)
       return context->diagnostic() << "'=' expected after result id.";
@@ -538,10 +583,10 @@ spv_result_t spvTextEncodeOpcode(const libspirv::AssemblyGrammar& grammar,
   }
 
   // NOTE: The table contains Opcode names without the "Op" prefix.
-  const char* pInstName = opcodeName.data() + 2;
+  const libspirv::TextToken instName = opcodeName.substr(2);
 
   spv_opcode_desc opcodeEntry;
-  error = grammar.lookupOpcode(pInstName, &opcodeEntry);
+  error = grammar.lookupOpcode(instName.data(), instName.size(), &opcodeEntry);
   if (error) {
     return context->diagnostic(error) << "Invalid Opcode name '"
                                       << context->getWord() << "'";
@@ -580,7 +625,7 @@ spv_result_t spvTextEncodeOpcode(const libspirv::AssemblyGrammar& grammar,
       // we inject its words into the instruction.
       spv_position_t temp_pos = context->position();
       error = spvTextEncodeOperand(grammar, context, SPV_OPERAND_TYPE_RESULT_ID,
-                                   result_id.c_str(), pInst, nullptr);
+                                   result_id, pInst, nullptr);
       result_id_position = context->position();
       // Because we are injecting we have to reset the position afterwards.
       context->setPosition(temp_pos);
@@ -610,12 +655,12 @@ spv_result_t spvTextEncodeOpcode(const libspirv::AssemblyGrammar& grammar,
         }
       }
 
-      std::string operandValue;
+      libspirv::TextToken operandValue;
       error = context->getWord(operandValue, &nextPosition);
       if (error) return context->diagnostic(error) << "Internal Error";
 
-      error = spvTextEncodeOperand(grammar, context, type, operandValue.c_str(),
-                                   pInst, &expectedOperands);
+      error = spvTextEncodeOperand(grammar, context, type, operandValue, pInst,
+                                   &expectedOperands);
 
       if (error == SPV_FAILED_MATCH && spvOperandIsOptional(type))
         return SPV_SUCCESS;
@@ -675,11 +720,65 @@ spv_result_t SetHeader(uint32_t* words, const uint32_t bound) {
   return SPV_SUCCESS;
 }
 
-// Translates a given assembly language module into binary form.
-// If a diagnostic is generated, it is not yet marked as being
-// for a text-based input.
+// The words of a module being assembled.  They are written either into a
+// buffer supplied by the caller, or into one which grows as needed and can
+// then be handed over to the caller.  The first SPV_INDEX_INSTRUCTION words
+// are reserved for the header.
+class ModuleWords {
+ public:
+  // Writes the words into a buffer that grows as needed.
+  ModuleWords()
+      : owned_(new uint32_t[1024]),
+        data_(owned_.get()),
+        capacity_(1024),
+        size_(SPV_INDEX_INSTRUCTION),
+        growable_(true) {}
+
+  // Writes the words into the given buffer, which has room for capacity
+  // words.  Words which do not fit are counted, but not written.
+  ModuleWords(uint32_t* data, size_t capacity)
+      : data_(data),
+        capacity_(capacity),
+        size_(SPV_INDEX_INSTRUCTION),
+        growable_(false) {}
+
+  // Appends count words to the module.
+  void append(const uint32_t* words, size_t count) {
+    if (size_ + count > capacity_ && growable_) {
+      capacity_ = std::max(capacity_ * 2, size_ + count);
+      std::unique_ptr<uint32_t[]> grown(new uint32_t[capacity_]);
+      memcpy(grown.get(), data_, sizeof(uint32_t) * size_);
+      owned_.swap(grown);
+      data_ = owned_.get();
+    }
+    if (size_ + count <= capacity_) {
+      memcpy(data_ + size_, words, sizeof(uint32_t) * count);
+    }
+    size_ += count;
+  }
+
+  // Returns true if all the words of the module have been written.
+  bool fits() const { return size_ <= capacity_; }
+
+  uint32_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+  // Returns the buffer that was grown, which the caller must delete[].
+  uint32_t* release() { return owned_.release(); }
+
+ private:
+  std::unique_ptr<uint32_t[]> owned_;
+  uint32_t* data_;
+  size_t capacity_;
+  size_t size_;
+  const bool growable_;
+};
+
+// Translates a given assembly language module into binary form, appending
+// its words to *words.  If a diagnostic is generated, it is not yet marked
+// as being for a text-based input.
 spv_result_t spvTextToBinaryInternal(const libspirv::AssemblyGrammar& grammar,
-                                     const spv_text text, spv_binary* pBinary,
+                                     const spv_text text, ModuleWords* words,
                                      spv_diagnostic* pDiagnostic) {
   if (!pDiagnostic) return SPV_ERROR_INVALID_DIAGNOSTIC;
   libspirv::AssemblyContext context(text, pDiagnostic);
@@ -688,68 +787,78 @@ spv_result_t spvTextToBinaryInternal(const libspirv::AssemblyGrammar& grammar,
   if (!grammar.isValid()) {
     return SPV_ERROR_INVALID_TABLE;
   }
-  if (!pBinary) return SPV_ERROR_INVALID_POINTER;
 
   // NOTE: Ensure diagnostic is zero initialised
   *pDiagnostic = {};
 
-  std::vector<spv_instruction_t> instructions;
+  // Each instruction is encoded into the same scratch instruction, whose
+  // words keep their storage from one instruction to the next, and then
+  // appended to the module.
+  spv_instruction_t inst = {};
 
   // Skip past whitespace and comments.
   context.advance();
 
   while (context.hasText()) {
-    instructions.push_back({});
-    spv_instruction_t& inst = instructions.back();
+    inst.opcode = SpvOpNop;
+    inst.extInstType = SPV_EXT_INST_TYPE_NONE;
+    inst.resultTypeId = 0;
+    inst.words.clear();
 
     if (spvTextEncodeOpcode(grammar, &context, &inst)) {
       return SPV_ERROR_INVALID_TEXT;
     }
+    words->append(inst.words.data(), inst.words.size());
 
     if (context.advance()) break;
   }
 
-  size_t totalSize = SPV_INDEX_INSTRUCTION;
-  for (auto& inst : instructions) {
-    totalSize += inst.words.size();
-  }
+  if (!words->fits()) return SPV_ERROR_BUFFER_TOO_SMALL;
+  return SetHeader(words->data(), context.getBound());
+}
 
-  uint32_t* data = new uint32_t[totalSize];
-  if (!data) return SPV_ERROR_OUT_OF_MEMORY;
-  uint64_t currentIndex = SPV_INDEX_INSTRUCTION;
-  for (auto& inst : instructions) {
-    memcpy(data + currentIndex, inst.words.data(),
-           sizeof(uint32_t) * inst.words.size());
-    currentIndex += inst.words.size();
-  }
+}  // anonymous namespace
+
+spv_result_t spvTextToBinary(const spv_const_context context,
+                             const char* input_text,
+                             const size_t input_text_size, spv_binary* pBinary,
+                             spv_diagnostic* pDiagnostic) {
+  if (!pBinary) return SPV_ERROR_INVALID_POINTER;
+  spv_text_t text = {input_text, input_text_size};
+  libspirv::AssemblyGrammar grammar(context);
+  ModuleWords words;
 
-  if (auto error = SetHeader(data, context.getBound())) return error;
+  spv_result_t result =
+      spvTextToBinaryInternal(grammar, &text, &words, pDiagnostic);
+  if (pDiagnostic && *pDiagnostic) (*pDiagnostic)->isTextSource = true;
+  if (result != SPV_SUCCESS) return result;
 
   spv_binary binary = new spv_binary_t();
-  if (!binary) {
-    delete[] data;
-    return SPV_ERROR_OUT_OF_MEMORY;
-  }
-  binary->code = data;
-  binary->wordCount = totalSize;
-
+  if (!binary) return SPV_ERROR_OUT_OF_MEMORY;
+  binary->wordCount = words.size();
+  binary->code = words.release();
   *pBinary = binary;
 
   return SPV_SUCCESS;
 }
 
-}  // anonymous namespace
-
-spv_result_t spvTextToBinary(const spv_const_context context,
-                             const char* input_text,
-                             const size_t input_text_size, spv_binary* pBinary,
-                             spv_diagnostic* pDiagnostic) {
+spv_result_t spvTextToBinaryBuffer(const spv_const_context context,
+                                   const char* input_text,
+                                   const size_t input_text_size,
+                                   uint32_t* binary, const size_t capacity,
+                                   size_t* wordCount,
+                                   spv_diagnostic* pDiagnostic) {
+  if (!wordCount || (!binary && capacity)) return SPV_ERROR_INVALID_POINTER;
   spv_text_t text = {input_text, input_text_size};
   libspirv::AssemblyGrammar grammar(context);
+  ModuleWords words(binary, capacity);
 
   spv_result_t result =
-      spvTextToBinaryInternal(grammar, &text, pBinary, pDiagnostic);
+      spvTextToBinaryInternal(grammar, &text, &words, pDiagnostic);
   if (pDiagnostic && *pDiagnostic) (*pDiagnostic)->isTextSource = true;
+  if (result == SPV_SUCCESS || result == SPV_ERROR_BUFFER_TOO_SMALL) {
+    *wordCount = words.size();
+  }
 
   return result;
 }
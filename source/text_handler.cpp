@@ -26,6 +26,7 @@
 
 #include "text_handler.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
@@ -40,12 +41,86 @@
 #include "util/bitutils.h"
 #include "util/hex_float.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SPIRV_TEXT_USE_SSE2
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
 namespace {
 
 using spvutils::BitwiseCast;
 using spvutils::FloatProxy;
 using spvutils::HexFloat;
 
+// A set of characters, tested one at a time or, with SSE2, sixteen at a time.
+template <char... Chars>
+struct CharSet;
+
+template <>
+struct CharSet<> {
+  static bool contains(char) { return false; }
+#if defined(SPIRV_TEXT_USE_SSE2)
+  static __m128i matches(__m128i) { return _mm_setzero_si128(); }
+#endif
+};
+
+template <char Char, char... Rest>
+struct CharSet<Char, Rest...> {
+  static bool contains(char ch) {
+    return ch == Char || CharSet<Rest...>::contains(ch);
+  }
+#if defined(SPIRV_TEXT_USE_SSE2)
+  // Returns 0xff in each byte of block which is in the set, and 0 elsewhere.
+  static __m128i matches(__m128i block) {
+    return _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(Char)),
+                        CharSet<Rest...>::matches(block));
+  }
+#endif
+};
+
+#if defined(SPIRV_TEXT_USE_SSE2)
+// Returns the index of the lowest set bit of the nonzero mask.
+inline uint32_t countTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return index;
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+/// @brief Find the first character which is, or is not, in a set
+///
+/// @param[in] str the characters to search
+/// @param[in] index where to start searching
+/// @param[in] end where to stop searching
+///
+/// @return the index of the first character from index up to end which is
+/// (if Member is true) or is not (if Member is false) one of Chars, or end if
+/// there is none
+template <bool Member, char... Chars>
+size_t scan(const char* str, size_t index, size_t end) {
+#if defined(SPIRV_TEXT_USE_SSE2)
+  for (; index + 16 <= end; index += 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + index));
+    uint32_t found = _mm_movemask_epi8(CharSet<Chars...>::matches(block));
+    if (!Member) found ^= 0xffff;
+    if (found) return index + countTrailingZeros(found);
+  }
+#endif
+  for (; index < end; ++index) {
+    if (CharSet<Chars...>::contains(str[index]) == Member) return index;
+  }
+  return end;
+}
+
 /// @brief Advance text to the start of the next line
 ///
 /// @param[in] text to be parsed
@@ -53,21 +128,15 @@ using spvutils::HexFloat;
 ///
 /// @return result code
 spv_result_t advanceLine(spv_text text, spv_position position) {
-  while (true) {
-    switch (text->str[position->index]) {
-      case '\0':
-        return SPV_END_OF_STREAM;
-      case '\n':
-        position->column = 0;
-        position->line++;
-        position->index++;
-        return SPV_SUCCESS;
-      default:
-        position->column++;
-        position->index++;
-        break;
-    }
-  }
+  const size_t end = scan<true, '\n', '\0'>(text->str, position->index,
+                                            text->length);
+  position->column += end - position->index;
+  position->index = end;
+  if (end == text->length || text->str[end] == '\0') return SPV_END_OF_STREAM;
+  position->column = 0;
+  position->line++;
+  position->index++;
+  return SPV_SUCCESS;
 }
 
 /// @brief Advance text to first non white space character
@@ -81,27 +150,27 @@ spv_result_t advanceLine(spv_text text, spv_position position) {
 /// @return result code
 spv_result_t advance(spv_text text, spv_position position) {
   // NOTE: Consume white space, otherwise don't advance.
-  if (position->index >= text->length) return SPV_END_OF_STREAM;
-  switch (text->str[position->index]) {
-    case '\0':
-      return SPV_END_OF_STREAM;
-    case ';':
-      if (spv_result_t error = advanceLine(text, position)) return error;
-      return advance(text, position);
-    case ' ':
-    case '\t':
-      position->column++;
-      position->index++;
-      return advance(text, position);
-    case '\n':
-      position->column = 0;
-      position->line++;
-      position->index++;
-      return advance(text, position);
-    default:
-      break;
+  while (true) {
+    const size_t end =
+        scan<false, ' ', '\t'>(text->str, position->index, text->length);
+    position->column += end - position->index;
+    position->index = end;
+    if (end == text->length) return SPV_END_OF_STREAM;
+    switch (text->str[end]) {
+      case '\0':
+        return SPV_END_OF_STREAM;
+      case ';':
+        if (spv_result_t error = advanceLine(text, position)) return error;
+        break;
+      case '\n':
+        position->column = 0;
+        position->line++;
+        position->index++;
+        break;
+      default:
+        return SPV_SUCCESS;
+    }
   }
-  return SPV_SUCCESS;
 }
 
 /// @brief Fetch the next word from the text stream.
@@ -111,50 +180,52 @@ spv_result_t advance(spv_text text, spv_position position) {
 ///
 /// @param[in] text stream to read from
 /// @param[in] position current position in text stream
-/// @param[out] word returned word
+/// @param[out] word returned word, referring to the characters of the text
 /// @param[out] endPosition one past the end of the returned word
 ///
 /// @return result code
-spv_result_t getWord(spv_text text, spv_position position, std::string& word,
-                     spv_position endPosition) {
+spv_result_t getWord(spv_text text, spv_position position,
+                     libspirv::TextToken& word, spv_position endPosition) {
   if (!text->str || !text->length) return SPV_ERROR_INVALID_TEXT;
   if (!position || !endPosition) return SPV_ERROR_INVALID_POINTER;
 
-  *endPosition = *position;
-
   bool quoting = false;
   bool escaping = false;
 
   // NOTE: Assumes first character is not white space!
+  size_t index = position->index;
   while (true) {
-    const char ch = text->str[endPosition->index];
-    if (ch == '\\')
+    // Skip the characters which can't end the word or change how the rest
+    // of it is read.
+    if (!escaping) {
+      index = quoting ? scan<true, '"', '\\', '\0'>(text->str, index,
+                                                     text->length)
+                      : scan<true, '"', '\\', '\0', ' ', ';', '\t', '\n'>(
+                            text->str, index, text->length);
+    }
+    if (index == text->length) break;
+
+    const char ch = text->str[index];
+    if (ch == '\\') {
       escaping = !escaping;
-    else {
-      switch (ch) {
-        case '"':
-          if (!escaping) quoting = !quoting;
-          break;
-        case ' ':
-        case ';':
-        case '\t':
-        case '\n':
-          if (escaping || quoting) break;
-        // Fall through.
-        case '\0': {  // NOTE: End of word found!
-          word.assign(text->str + position->index,
-                      (size_t)(endPosition->index - position->index));
-          return SPV_SUCCESS;
-        }
-        default:
-          break;
+    } else {
+      if (ch == '\0') break;  // NOTE: End of word found!
+      if (ch == '"') {
+        if (!escaping) quoting = !quoting;
+      } else if (!escaping && !quoting) {
+        break;  // NOTE: End of word found!
       }
       escaping = false;
     }
-
-    endPosition->column++;
-    endPosition->index++;
+    index++;
   }
+
+  *endPosition = *position;
+  endPosition->column += index - position->index;
+  endPosition->index = index;
+  word = libspirv::TextToken(text->str + position->index,
+                             index - position->index);
+  return SPV_SUCCESS;
 }
 
 // Returns true if the characters in the text as position represent
@@ -173,15 +244,71 @@ namespace libspirv {
 
 const IdType kUnknownType = {0, false, IdTypeClass::kBottom};
 
+namespace {
+
+// Returns a hash of the characters of name, mixed in eight at a time.
+uint32_t HashName(const TextToken& name) {
+  const uint64_t kMultiplier = 0x9e3779b97f4a7c15ULL;
+  uint64_t hash = name.size();
+  const char* p = name.data();
+  size_t left = name.size();
+  for (; left >= 8; p += 8, left -= 8) {
+    uint64_t word;
+    memcpy(&word, p, 8);
+    hash = (hash ^ word) * kMultiplier;
+    hash ^= hash >> 32;
+  }
+  if (left) {
+    uint64_t word = 0;
+    memcpy(&word, p, left);
+    hash = (hash ^ word) * kMultiplier;
+  }
+  // The high bits of the product depend on all the bits of the input.
+  return uint32_t(hash >> 32);
+}
+
+}  // anonymous namespace
+
+uint32_t NamedIdTable::findOrInsert(const TextToken& name, uint32_t new_id) {
+  assert(new_id != 0);
+  // Keep at least half of the slots empty, so probes stay short.
+  if ((size_ + 1) * 2 > slots_.size()) grow();
+  const uint32_t hash = HashName(name);
+  const size_t mask = slots_.size() - 1;
+  for (size_t index = hash & mask;; index = (index + 1) & mask) {
+    Slot& slot = slots_[index];
+    if (slot.id == 0) {
+      slot = {name.data(), name.size(), hash, new_id};
+      ++size_;
+      return new_id;
+    }
+    if (slot.hash == hash && slot.name_size == name.size() &&
+        !memcmp(slot.name, name.data(), name.size()))
+      return slot.id;
+  }
+}
+
+void NamedIdTable::grow() {
+  std::vector<Slot> old_slots(std::max(size_t(64), slots_.size() * 2),
+                              Slot{nullptr, 0, 0, 0});
+  old_slots.swap(slots_);
+  const size_t mask = slots_.size() - 1;
+  for (const Slot& slot : old_slots) {
+    if (slot.id == 0) continue;
+    size_t index = slot.hash & mask;
+    while (slots_[index].id != 0) index = (index + 1) & mask;
+    slots_[index] = slot;
+  }
+}
+
 // TODO(dneto): Reorder AssemblyContext definitions to match declaration order.
 
 // This represents all of the data that is only valid for the duration of
 // a single compilation.
-uint32_t AssemblyContext::spvNamedIdAssignOrGet(const char* textValue) {
-  if (named_ids_.end() == named_ids_.find(textValue)) {
-    named_ids_[std::string(textValue)] = bound_++;
-  }
-  return named_ids_[textValue];
+uint32_t AssemblyContext::spvNamedIdAssignOrGet(const TextToken& textValue) {
+  const uint32_t id = named_ids_.findOrInsert(textValue, bound_);
+  if (id == bound_) ++bound_;
+  return id;
 }
 uint32_t AssemblyContext::getBound() const { return bound_; }
 
@@ -189,7 +316,7 @@ spv_result_t AssemblyContext::advance() {
   return ::advance(text_, &current_position_);
 }
 
-spv_result_t AssemblyContext::getWord(std::string& word,
+spv_result_t AssemblyContext::getWord(TextToken& word,
                                       spv_position endPosition) {
   return ::getWord(text_, &current_position_, word, endPosition);
 }
@@ -203,7 +330,7 @@ bool AssemblyContext::isStartOfNewInst() {
   if (::advance(text_, &nextPosition)) return false;
   if (::startsWithOp(text_, &nextPosition)) return true;
 
-  std::string word;
+  TextToken word;
   spv_position_t startPosition = current_position_;
   if (::getWord(text_, &startPosition, word, &nextPosition)) return false;
   if ('%' != word.front()) return false;
@@ -227,23 +354,12 @@ bool AssemblyContext::hasText() const {
   return text_->length > current_position_.index;
 }
 
-std::string AssemblyContext::getWord() const {
-  uint64_t index = current_position_.index;
-  while (true) {
-    switch (text_->str[index]) {
-      case '\0':
-      case '\t':
-      case '\v':
-      case '\r':
-      case '\n':
-      case ' ':
-        return std::string(text_->str, text_->str + index);
-      default:
-        index++;
-    }
-  }
-  assert(0 && "Unreachable");
-  return "";  // Make certain compilers happy.
+TextToken AssemblyContext::getWord() const {
+  const size_t start = size_t(current_position_.index);
+  if (start >= text_->length) return TextToken();
+  const size_t end = scan<true, '\0', '\t', '\v', '\r', '\n', ' '>(
+      text_->str, start, text_->length);
+  return TextToken(text_->str + start, end - start);
 }
 
 void AssemblyContext::seekForward(uint32_t size) {
@@ -267,7 +383,7 @@ spv_result_t AssemblyContext::binaryEncodeU64(const uint64_t value,
 }
 
 spv_result_t AssemblyContext::binaryEncodeNumericLiteral(
-    const char* val, spv_result_t error_code, const IdType& type,
+    const TextToken& val, spv_result_t error_code, const IdType& type,
     spv_instruction_t* pInst) {
   const bool is_bottom = type.type_class == libspirv::IdTypeClass::kBottom;
   const bool is_floating = libspirv::isScalarFloating(type);
@@ -280,7 +396,7 @@ spv_result_t AssemblyContext::binaryEncodeNumericLiteral(
 
   // If this is bottom, but looks like a float, we should treat it like a
   // float.
-  const bool looks_like_float = is_bottom && strchr(val, '.');
+  const bool looks_like_float = is_bottom && val.contains('.');
 
   // If we explicitly expect a floating-point number, we should handle that
   // first.
@@ -290,9 +406,9 @@ spv_result_t AssemblyContext::binaryEncodeNumericLiteral(
   return binaryEncodeIntegerLiteral(val, error_code, type, pInst);
 }
 
-spv_result_t AssemblyContext::binaryEncodeString(const char* value,
+spv_result_t AssemblyContext::binaryEncodeString(const TextToken& value,
                                                  spv_instruction_t* pInst) {
-  const size_t length = strlen(value);
+  const size_t length = value.size();
   const size_t wordCount = (length / 4) + 1;
   const size_t oldWordCount = pInst->words.size();
   const size_t newWordCount = oldWordCount + wordCount;
@@ -310,7 +426,7 @@ spv_result_t AssemblyContext::binaryEncodeString(const char* value,
   pInst->words.back() = 0;
 
   char* dest = (char*)&pInst->words[oldWordCount];
-  strncpy(dest, value, length);
+  memcpy(dest, value.data(), length);
 
   return SPV_SUCCESS;
 }
@@ -383,13 +499,17 @@ spv_ext_inst_type_t AssemblyContext::getExtInstTypeForId(uint32_t id) const {
 }
 
 spv_result_t AssemblyContext::binaryEncodeFloatingPointLiteral(
-    const char* val, spv_result_t error_code, const IdType& type,
+    const TextToken& val, spv_result_t error_code, const IdType& type,
     spv_instruction_t* pInst) {
   const auto bit_width = assumedBitWidth(type);
   switch (bit_width) {
-    case 16:
-      return diagnostic(SPV_ERROR_INTERNAL)
-             << "Unsupported yet: 16-bit float constants.";
+    case 16: {
+      spvutils::HexFloat<FloatProxy<spvutils::Float16>> hVal(uint16_t(0));
+      if (auto error = parseNumber(val, error_code, &hVal,
+                                   "Invalid 16-bit float literal: "))
+        return error;
+      return binaryEncodeU32(hVal.value().data(), pInst);
+    } break;
     case 32: {
       spvutils::HexFloat<FloatProxy<float>> fVal(0.0f);
       if (auto error = parseNumber(val, error_code, &fVal,
@@ -411,7 +531,7 @@ spv_result_t AssemblyContext::binaryEncodeFloatingPointLiteral(
 }
 
 spv_result_t AssemblyContext::binaryEncodeIntegerLiteral(
-    const char* val, spv_result_t error_code, const IdType& type,
+    const TextToken& val, spv_result_t error_code, const IdType& type,
     spv_instruction_t* pInst) {
   const bool is_bottom = type.type_class == libspirv::IdTypeClass::kBottom;
   const auto bit_width = assumedBitWidth(type);
@@ -27,19 +27,117 @@
 #ifndef LIBSPIRV_TEXT_HANDLER_H_
 #define LIBSPIRV_TEXT_HANDLER_H_
 
+#include <cstring>
 #include <iomanip>
+#include <ostream>
 #include <sstream>
+#include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "diagnostic.h"
 #include "instruction.h"
 #include "libspirv/libspirv.h"
 #include "text.h"
+#include "util/parse_number.h"
 
 namespace libspirv {
 // Structures
 
+// A word of assembly text.  It refers to characters of the text without
+// owning or copying them, so it is valid only as long as the text is.
+class TextToken {
+ public:
+  TextToken() : data_(nullptr), size_(0) {}
+  TextToken(const char* data, size_t size) : data_(data), size_(size) {}
+  // Refers to the given null-terminated string.
+  TextToken(const char* str) : data_(str), size_(strlen(str)) {}
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Returns the character at the given index, or '\0' if the index is past
+  // the end of the token, as if the token were null-terminated.
+  char operator[](size_t index) const {
+    return index < size_ ? data_[index] : '\0';
+  }
+  char front() const { return (*this)[0]; }
+  char back() const { return size_ ? data_[size_ - 1] : '\0'; }
+
+  // Returns the token without its first count characters.
+  TextToken substr(size_t count) const {
+    return count < size_ ? TextToken(data_ + count, size_ - count)
+                         : TextToken();
+  }
+
+  // Returns true if the token contains the given character.
+  bool contains(char ch) const {
+    return size_ && memchr(data_, ch, size_) != nullptr;
+  }
+
+  // Returns a copy of the characters of the token.
+  std::string str() const { return std::string(data_, size_); }
+
+ private:
+  const char* data_;
+  size_t size_;
+};
+
+inline bool operator==(const TextToken& token, const char* str) {
+  return !strncmp(str, token.data(), token.size()) && !str[token.size()];
+}
+inline bool operator==(const char* str, const TextToken& token) {
+  return token == str;
+}
+inline bool operator!=(const TextToken& token, const char* str) {
+  return !(token == str);
+}
+inline bool operator!=(const char* str, const TextToken& token) {
+  return !(token == str);
+}
+inline bool operator==(const std::string& str, const TextToken& token) {
+  return str.size() == token.size() &&
+         !memcmp(str.data(), token.data(), token.size());
+}
+
+inline std::ostream& operator<<(std::ostream& out, const TextToken& token) {
+  return out.write(token.data(), token.size());
+}
+
+// Maps the names of IDs to their numbers.  The names are kept as TextTokens
+// rather than copied, so they must be valid as long as the table is, as the
+// words of the assembly text being assembled are.  The table uses open
+// addressing with linear probing, and keeps the hash of each name so that
+// most mismatches are found without comparing characters.
+class NamedIdTable {
+ public:
+  NamedIdTable() : size_(0) {}
+
+  // Returns the number of the ID with the given name.  If there is none,
+  // records new_id as its number and returns that.  new_id must not be 0.
+  uint32_t findOrInsert(const TextToken& name, uint32_t new_id);
+
+  // Returns the number of names in the table.
+  size_t size() const { return size_; }
+
+ private:
+  // An entry of the table, which is empty if its id is 0.
+  struct Slot {
+    const char* name;
+    size_t name_size;
+    uint32_t hash;
+    uint32_t id;
+  };
+
+  // Doubles the number of slots, and moves the entries to their new places.
+  void grow();
+
+  std::vector<Slot> slots_;
+  size_t size_;
+};
+
 // This is a lattice for tracking types.
 enum class IdTypeClass {
   kBottom = 0,  // We have no information yet.
@@ -99,31 +197,37 @@ inline int assumedBitWidth(const IdType& type) {
   return 0;
 }
 
-// A templated class with a static member function Clamp, where Clamp
-// sets a referenced value of type T to 0 if T is an unsigned
-// integer type, and returns true if it modified the referenced
-// value.
-template <typename T, typename = void>
-class ClampToZeroIfUnsignedType {
- public:
-  // The default specialization does not clamp the value.
-  static bool Clamp(T*) { return false; }
-};
+// Parses all of text as a number of integer type T, without allocating.
+// Returns true and sets *value on success.
+template <typename T>
+bool ParseNumberFromText(const TextToken& text, T* value,
+                         std::true_type /* is_integral */) {
+  return spvutils::ParseInteger(text.data(), text.size(), value);
+}
 
-// The specialization of ClampToZeroIfUnsignedType for unsigned integer
-// types.
+// Parses all of text as a number of non-integer type T, by extracting it from
+// a stream.  Returns true and sets *value on success.
 template <typename T>
-class ClampToZeroIfUnsignedType<
-    T, typename std::enable_if<std::is_unsigned<T>::value>::type> {
- public:
-  static bool Clamp(T* value_pointer) {
-    if (*value_pointer) {
-      *value_pointer = 0;
-      return true;
-    }
-    return false;
-  }
-};
+bool ParseNumberFromText(const TextToken& text, T* value,
+                         std::false_type /* is_integral */) {
+  std::istringstream text_stream(text.str());
+  text_stream >> std::setbase(0);
+  text_stream >> *value;
+  // We should have read something, it should have been all the text, and it
+  // should have been in range.
+  return !text.empty() && !text_stream.bad() && text_stream.eof() &&
+         !text_stream.fail();
+}
+
+// Parses all of text as a float held in a HexFloat, the way extracting it
+// from a stream would, but without the stream in the common cases.  Returns
+// true and sets *value on success.
+template <typename T>
+bool ParseNumberFromText(const TextToken& text,
+                         spvutils::HexFloat<spvutils::FloatProxy<T>>* value,
+                         std::false_type /* is_integral */) {
+  return spvutils::ParseFloat(text.data(), text.size(), value);
+}
 
 // Encapsulates the data used during the assembly of a SPIR-V module.
 class AssemblyContext {
@@ -136,7 +240,7 @@ class AssemblyContext {
 
   // Assigns a new integer value to the given text ID, or returns the previously
   // assigned integer value if the ID has been seen before.
-  uint32_t spvNamedIdAssignOrGet(const char* textValue);
+  uint32_t spvNamedIdAssignOrGet(const TextToken& textValue);
 
   // Returns the largest largest numeric ID that has been assigned.
   uint32_t getBound() const;
@@ -147,12 +251,12 @@ class AssemblyContext {
 
   // Sets word to the next word in the input text. Fills endPosition with
   // the next location past the end of the word.
-  spv_result_t getWord(std::string& word, spv_position endPosition);
+  spv_result_t getWord(TextToken& word, spv_position endPosition);
 
   // Returns the next word in the input stream. It is invalid to call this
   // method if position has been set to a location in the stream that does not
   // exist. If there are no subsequent words, the empty string will be returned.
-  std::string getWord() const;
+  TextToken getWord() const;
 
   // Returns true if the next word in the input is the start of a new Opcode.
   bool startsWithOp();
@@ -199,7 +303,8 @@ class AssemblyContext {
   // Appends the given string to the given instruction.
   // Returns SPV_SUCCESS if the value could be correctly inserted in the
   // instruction.
-  spv_result_t binaryEncodeString(const char* value, spv_instruction_t* pInst);
+  spv_result_t binaryEncodeString(const TextToken& value,
+                                  spv_instruction_t* pInst);
 
   // Appends the given numeric literal to the given instruction.
   // Validates and respects the bitwidth supplied in the IdType argument.
@@ -208,7 +313,7 @@ class AssemblyContext {
   // Returns SPV_SUCCESS if the value could be correctly added to the
   // instruction.  Returns the given error code on failure, and emits
   // a diagnostic if that error code is not SPV_FAILED_MATCH.
-  spv_result_t binaryEncodeNumericLiteral(const char* numeric_literal,
+  spv_result_t binaryEncodeNumericLiteral(const TextToken& numeric_literal,
                                           spv_result_t error_code,
                                           const IdType& type,
                                           spv_instruction_t* pInst);
@@ -249,35 +354,11 @@ class AssemblyContext {
   // referenced by value_pointer. On failure, returns the given error code,
   // and emits a diagnostic if that error code is not SPV_FAILED_MATCH.
   template <typename T>
-  spv_result_t parseNumber(const char* text, spv_result_t error_code,
+  spv_result_t parseNumber(const TextToken& text, spv_result_t error_code,
                            T* value_pointer,
                            const char* error_message_fragment) {
-    // C++11 doesn't define std::istringstream(int8_t&), so calling this method
-    // with a single-byte type leads to implementation-defined behaviour.
-    // Similarly for uint8_t.
-    static_assert(sizeof(T) > 1,
-                  "Don't use a single-byte type this parse method");
-
-    std::istringstream text_stream(text);
-    // Allow both decimal and hex input for integers.
-    // It also allows octal input, but we don't care about that case.
-    text_stream >> std::setbase(0);
-    text_stream >> *value_pointer;
-    bool ok = true;
-
-    // We should have read something.
-    ok = (text[0] != 0) && !text_stream.bad();
-    // It should have been all the text.
-    ok = ok && text_stream.eof();
-    // It should have been in range.
-    ok = ok && !text_stream.fail();
-
-    // Work around a bug in the GNU C++11 library. It will happily parse
-    // "-1" for uint16_t as 65535.
-    if (ok && text[0] == '-')
-      ok = !ClampToZeroIfUnsignedType<T>::Clamp(value_pointer);
-
-    if (ok) return SPV_SUCCESS;
+    if (ParseNumberFromText(text, value_pointer, std::is_integral<T>()))
+      return SPV_SUCCESS;
     return diagnostic(error_code) << error_message_fragment << text;
   }
 
@@ -286,18 +367,17 @@ class AssemblyContext {
   // Returns SPV_SUCCESS if the value was correctly parsed.  Otherwise
   // returns the given error code, and emits a diagnostic if that error
   // code is not SPV_FAILED_MATCH.
-  // Only 32 and 64 bit floating point numbers are supported.
-  spv_result_t binaryEncodeFloatingPointLiteral(const char* numeric_literal,
-                                                spv_result_t error_code,
-                                                const IdType& type,
-                                                spv_instruction_t* pInst);
+  // Only 16, 32 and 64 bit floating point numbers are supported.
+  spv_result_t binaryEncodeFloatingPointLiteral(
+      const TextToken& numeric_literal, spv_result_t error_code,
+      const IdType& type, spv_instruction_t* pInst);
 
   // Appends the given integer literal to the given instruction.
   // Returns SPV_SUCCESS if the value was correctly parsed.  Otherwise
   // returns the given error code, and emits a diagnostic if that error
   // code is not SPV_FAILED_MATCH.
   // Integers up to 64 bits are supported.
-  spv_result_t binaryEncodeIntegerLiteral(const char* numeric_literal,
+  spv_result_t binaryEncodeIntegerLiteral(const TextToken& numeric_literal,
                                           spv_result_t error_code,
                                           const IdType& type,
                                           spv_instruction_t* pInst);
@@ -319,14 +399,13 @@ class AssemblyContext {
   // Writes the given 64-bit literal value into the instruction.
   // return SPV_SUCCESS if the value could be written in the instruction.
   spv_result_t binaryEncodeU64(const uint64_t value, spv_instruction_t* pInst);
-  // Maps ID names to their corresponding numerical ids.
-  using spv_named_id_table = std::unordered_map<std::string, uint32_t>;
   // Maps type-defining IDs to their IdType.
   using spv_id_to_type_map = std::unordered_map<uint32_t, IdType>;
   // Maps Ids to the id of their type.
   using spv_id_to_type_id = std::unordered_map<uint32_t, uint32_t>;
 
-  spv_named_id_table named_ids_;
+  // Maps ID names to their corresponding numerical ids.
+  NamedIdTable named_ids_;
   spv_id_to_type_map types_;
   spv_id_to_type_id value_types_;
   // Maps an extended instruction import Id to the extended instruction type.
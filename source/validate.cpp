@@ -37,17 +37,19 @@
 #include "spirv_endian.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <cstdio>
 #include <functional>
 #include <iterator>
 #include <map>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
-using std::function;
 using std::map;
 using std::ostream_iterator;
 using std::placeholders::_1;
@@ -208,77 +210,89 @@ spv_result_t spvValidateBasic(const spv_instruction_t* pInsts,
 }
 #endif
 
-spv_result_t spvValidateIDs(const spv_instruction_t* pInsts,
-                            const uint64_t count, const uint32_t bound,
-                            const spv_opcode_table opcodeTable,
-                            const spv_operand_table operandTable,
-                            const spv_ext_inst_table extInstTable,
-                            spv_position position,
-                            spv_diagnostic* pDiagnostic) {
-  std::vector<spv_id_info_t> idUses;
-  std::vector<spv_id_info_t> idDefs;
-
-  for (uint64_t instIndex = 0; instIndex < count; ++instIndex) {
-    const uint32_t* words = pInsts[instIndex].words.data();
-    SpvOp opcode;
-    spvOpcodeSplit(words[0], nullptr, &opcode);
-
-    spv_opcode_desc opcodeEntry = nullptr;
-    if (spvOpcodeTableValueLookup(opcodeTable, opcode, &opcodeEntry)) {
-      DIAGNOSTIC << "Invalid Opcode '" << opcode << "'.";
-      return SPV_ERROR_INVALID_BINARY;
-    }
-
-    spv_operand_desc operandEntry = nullptr;
-    position->index++;  // NOTE: Account for Opcode word
-    for (uint16_t index = 1; index < pInsts[instIndex].words.size();
-         ++index, position->index++) {
-      const uint32_t word = words[index];
+namespace {
 
-      spv_operand_type_t type = spvBinaryOperandInfo(
-          word, index, opcodeEntry, operandTable, &operandEntry);
+// Returns the first entry in the list whose ID is 0 or exceeds the bound, or
+// nullptr if there is none.
+const spv_id_info_t* FindFirstInvalidId(const spv_id_info_t* pIds,
+                                        const uint64_t idsCount,
+                                        const uint32_t bound) {
+  for (uint64_t i = 0; i < idsCount; ++i) {
+    if (0 == pIds[i].id || bound < pIds[i].id) return &pIds[i];
+  }
+  return nullptr;
+}
 
-      if (SPV_OPERAND_TYPE_RESULT_ID == type || SPV_OPERAND_TYPE_ID == type) {
-        if (0 == word) {
-          DIAGNOSTIC << "Invalid ID of '0' is not allowed.";
-          return SPV_ERROR_INVALID_ID;
-        }
-        if (bound < word) {
-          DIAGNOSTIC << "Invalid ID '" << word << "' exceeds the bound '"
-                     << bound << "'.";
-          return SPV_ERROR_INVALID_ID;
-        }
-      }
+// Returns the first definition in the list whose ID is also defined by
+// another entry, or nullptr if every ID is defined once.
+const spv_id_info_t* FindFirstMultiplyDefinedId(
+    const spv_id_info_t* pIdDefs, const uint64_t idDefsCount) {
+  std::vector<uint32_t> ids;
+  ids.reserve(idDefsCount);
+  for (uint64_t i = 0; i < idDefsCount; ++i) ids.push_back(pIdDefs[i].id);
+  std::sort(ids.begin(), ids.end());
+  // Collect the IDs which appear more than once, in sorted order.
+  std::vector<uint32_t> repeated;
+  for (size_t i = 1; i < ids.size(); ++i) {
+    if (ids[i] == ids[i - 1] && (repeated.empty() || repeated.back() != ids[i]))
+      repeated.push_back(ids[i]);
+  }
+  if (repeated.empty()) return nullptr;
+  for (uint64_t i = 0; i < idDefsCount; ++i) {
+    if (std::binary_search(repeated.begin(), repeated.end(), pIdDefs[i].id))
+      return &pIdDefs[i];
+  }
+  return nullptr;
+}
 
-      if (SPV_OPERAND_TYPE_RESULT_ID == type) {
-        idDefs.push_back(
-            {word, opcodeEntry->opcode, &pInsts[instIndex], *position});
-      }
+}  // anonymous namespace
 
-      if (SPV_OPERAND_TYPE_ID == type) {
-        idUses.push_back({word, opcodeEntry->opcode, nullptr, *position});
-      }
+spv_result_t spvValidateIDs(const spv_instruction_view_t* pInsts,
+                            const uint64_t count, const spv_id_info_t* pIdUses,
+                            const uint64_t idUsesCount,
+                            const spv_id_info_t* pIdDefs,
+                            const uint64_t idDefsCount, const uint32_t bound,
+                            const spv_opcode_table opcodeTable,
+                            const spv_operand_table operandTable,
+                            const spv_ext_inst_table extInstTable,
+                            const uint32_t threadCount, spv_position position,
+                            spv_diagnostic* pDiagnostic) {
+  // NOTE: Error on the first ID, defined or used, which is 0 or out of bounds
+  const spv_id_info_t* invalidDef =
+      FindFirstInvalidId(pIdDefs, idDefsCount, bound);
+  const spv_id_info_t* invalidUse =
+      FindFirstInvalidId(pIdUses, idUsesCount, bound);
+  const spv_id_info_t* invalid = invalidDef;
+  if (!invalid || (invalidUse && invalidUse->position.index <
+                                     invalidDef->position.index)) {
+    invalid = invalidUse;
+  }
+  if (invalid) {
+    position->index = invalid->position.index;
+    if (0 == invalid->id) {
+      DIAGNOSTIC << "Invalid ID of '0' is not allowed.";
+    } else {
+      DIAGNOSTIC << "Invalid ID '" << invalid->id << "' exceeds the bound '"
+                 << bound << "'.";
     }
+    return SPV_ERROR_INVALID_ID;
   }
 
-  // NOTE: Error on redefined ID
-  for (size_t outerIndex = 0; outerIndex < idDefs.size(); ++outerIndex) {
-    for (size_t innerIndex = 0; innerIndex < idDefs.size(); ++innerIndex) {
-      if (outerIndex == innerIndex) {
-        continue;
-      }
-      if (idDefs[outerIndex].id == idDefs[innerIndex].id) {
-        DIAGNOSTIC << "Multiply defined ID '" << idDefs[outerIndex].id << "'.";
-        return SPV_ERROR_INVALID_ID;
-      }
+  // NOTE: Error on redefined ID, reported at the end of the module
+  if (const spv_id_info_t* redefined =
+          FindFirstMultiplyDefinedId(pIdDefs, idDefsCount)) {
+    for (uint64_t instIndex = 0; instIndex < count; ++instIndex) {
+      position->index += pInsts[instIndex].words.size();
     }
+    DIAGNOSTIC << "Multiply defined ID '" << redefined->id << "'.";
+    return SPV_ERROR_INVALID_ID;
   }
 
   // NOTE: Validate ID usage, including use of undefined ID's
   position->index = SPV_INDEX_INSTRUCTION;
-  if (spvValidateInstructionIDs(pInsts, count, idUses.data(), idUses.size(),
-                                idDefs.data(), idDefs.size(), opcodeTable,
-                                operandTable, extInstTable, position,
+  if (spvValidateInstructionIDs(pInsts, count, pIdUses, idUsesCount, pIdDefs,
+                                idDefsCount, bound, opcodeTable, operandTable,
+                                extInstTable, threadCount, position,
                                 pDiagnostic))
     return SPV_ERROR_INVALID_ID;
 
@@ -305,17 +319,78 @@ spv_result_t setHeader(void* user_data, spv_endianness_t endian, uint32_t magic,
   return SPV_SUCCESS;
 }
 
-// Performs SSA validation on the IDs of an instruction. The
-// can_have_forward_declared_ids  functor should return true if the
-// instruction operand's ID can be forward referenced.
+// A range of operand indices of an instruction.
+struct OperandRange {
+  uint16_t first;
+  uint16_t last;
+
+  bool contains(unsigned index) const {
+    return first <= index && index <= last;
+  }
+};
+
+const uint16_t kLastOperand = UINT16_MAX;
+const OperandRange kNoOperands = {1, 0};
+
+// Returns a table mapping each opcode to the range of operands of its
+// instructions which may be forward referenced. This table is used in the SSA
+// validation stage of the pipeline.
+const vector<OperandRange>& GetForwardReferenceTable() {
+  struct Entry {
+    SpvOp opcode;
+    OperandRange operands;
+  };
+  // clang-format off
+  static const Entry entries[] = {
+    {SpvOpExecutionMode, {0, kLastOperand}},
+    {SpvOpEntryPoint, {0, kLastOperand}},
+    {SpvOpName, {0, kLastOperand}},
+    {SpvOpMemberName, {0, kLastOperand}},
+    {SpvOpSelectionMerge, {0, kLastOperand}},
+    {SpvOpDecorate, {0, kLastOperand}},
+    {SpvOpMemberDecorate, {0, kLastOperand}},
+    {SpvOpBranch, {0, kLastOperand}},
+    {SpvOpLoopMerge, {0, kLastOperand}},
+    {SpvOpGroupDecorate, {1, kLastOperand}},
+    {SpvOpGroupMemberDecorate, {1, kLastOperand}},
+    {SpvOpBranchConditional, {1, kLastOperand}},
+    {SpvOpSwitch, {1, kLastOperand}},
+    {SpvOpFunctionCall, {2, 2}},
+    {SpvOpPhi, {2, kLastOperand}},
+    {SpvOpEnqueueKernel, {8, 8}},
+    {SpvOpGetKernelNDrangeSubGroupCount, {3, 3}},
+    {SpvOpGetKernelNDrangeMaxSubGroupSize, {3, 3}},
+    {SpvOpGetKernelWorkGroupSize, {2, 2}},
+    {SpvOpGetKernelPreferredWorkGroupSizeMultiple, {2, 2}},
+  };
+  // clang-format on
+  static const vector<OperandRange> table = [] {
+    size_t size = 0;
+    for (const Entry& entry : entries) {
+      size = std::max(size, size_t(entry.opcode) + 1);
+    }
+    vector<OperandRange> ranges(size, kNoOperands);
+    for (const Entry& entry : entries) ranges[entry.opcode] = entry.operands;
+    return ranges;
+  }();
+  return table;
+}
+
+// Returns the range of operands of an instruction with the opcode which may
+// be forward referenced.
+OperandRange GetForwardReferenceOperands(SpvOp opcode) {
+  const vector<OperandRange>& table = GetForwardReferenceTable();
+  return size_t(opcode) < table.size() ? table[opcode] : kNoOperands;
+}
+
+// Performs SSA validation on the IDs of an instruction.
 //
-// TODO(umar): Use dominators to correctly validate SSA. For example, the result
-// id from a 'then' block cannot dominate its usage in the 'else' block. This
-// is not yet performed by this funciton.
+// NOTE: Whether definitions dominate their uses is checked by DominancePass.
 spv_result_t SsaPass(ValidationState_t& _,
-                     function<bool(unsigned)> can_have_forward_declared_ids,
                      const spv_parsed_instruction_t* inst) {
   if (_.is_enabled(SPV_VALIDATE_SSA_BIT)) {
+    const OperandRange can_have_forward_declared_ids =
+        GetForwardReferenceOperands(inst->opcode);
     for (unsigned i = 0; i < inst->num_operands; i++) {
       const spv_parsed_operand_t& operand = inst->operands[i];
       const spv_operand_type_t& type = operand.type;
@@ -333,9 +408,10 @@ spv_result_t SsaPass(ValidationState_t& _,
         case SPV_OPERAND_TYPE_SCOPE_ID:
           if (_.isDefinedId(*operand_ptr)) {
             ret = SPV_SUCCESS;
-          } else if (can_have_forward_declared_ids(i)) {
+          } else if (can_have_forward_declared_ids.contains(i)) {
             ret = _.forwardDeclareId(*operand_ptr);
           } else {
+            _.sortIdNames();
             ret = _.diag(SPV_ERROR_INVALID_ID) << "ID "
                                                << _.getIdName(*operand_ptr)
                                                << " has not been defined";
@@ -353,58 +429,86 @@ spv_result_t SsaPass(ValidationState_t& _,
   return SPV_SUCCESS;
 }
 
-// This funciton takes the opcode of an instruction and returns
-// a function object that will return true if the index
-// of the operand can be forwarad declared. This function will
-// used in the SSA validation stage of the pipeline
-function<bool(unsigned)> getCanBeForwardDeclaredFunction(SpvOp opcode) {
-  function<bool(unsigned index)> out;
+// Returns true if the operand at index i of an instruction with the opcode is
+// the label of a block which it branches to.
+bool IsBranchTarget(SpvOp opcode, unsigned i) {
   switch (opcode) {
-    case SpvOpExecutionMode:
-    case SpvOpEntryPoint:
-    case SpvOpName:
-    case SpvOpMemberName:
-    case SpvOpSelectionMerge:
-    case SpvOpDecorate:
-    case SpvOpMemberDecorate:
     case SpvOpBranch:
-    case SpvOpLoopMerge:
-      out = [](unsigned) { return true; };
-      break;
-    case SpvOpGroupDecorate:
-    case SpvOpGroupMemberDecorate:
+      return true;
     case SpvOpBranchConditional:
+      return i == 1 || i == 2;
     case SpvOpSwitch:
-      out = [](unsigned index) { return index != 0; };
-      break;
-
-    case SpvOpFunctionCall:
-      out = [](unsigned index) { return index == 2; };
-      break;
-
-    case SpvOpPhi:
-      out = [](unsigned index) { return index > 1; };
-      break;
-
-    case SpvOpEnqueueKernel:
-      out = [](unsigned index) { return index == 8; };
-      break;
-
-    case SpvOpGetKernelNDrangeSubGroupCount:
-    case SpvOpGetKernelNDrangeMaxSubGroupSize:
-      out = [](unsigned index) { return index == 3; };
-      break;
+      return i != 0;
+    default:
+      return false;
+  }
+}
 
-    case SpvOpGetKernelWorkGroupSize:
-    case SpvOpGetKernelPreferredWorkGroupSizeMultiple:
-      out = [](unsigned index) { return index == 2; };
-      break;
+// Records the control flow graph of each function, and where the IDs in it are
+// defined and used.  At the end of each function, checks that the definition
+// of each ID dominates its uses.
+spv_result_t DominancePass(ValidationState_t& _,
+                           const spv_parsed_instruction_t* inst) {
+  if (!_.is_enabled(SPV_VALIDATE_SSA_BIT)) return SPV_SUCCESS;
 
+  libspirv::FunctionCfg& cfg = _.functionCfg();
+  const SpvOp opcode = inst->opcode;
+  switch (opcode) {
+    case SpvOpFunction:
+      cfg.beginFunction();
+      return SPV_SUCCESS;
+    case SpvOpFunctionParameter:
+      if (cfg.inFunction()) cfg.addParameter(inst->result_id);
+      return SPV_SUCCESS;
+    case SpvOpLabel:
+      if (cfg.inFunction()) cfg.beginBlock(inst->result_id);
+      return SPV_SUCCESS;
+    case SpvOpFunctionEnd: {
+      if (!cfg.inFunction()) return SPV_SUCCESS;
+      cfg.endFunction();
+      libspirv::FunctionCfg::UndominatedUse use;
+      if (!cfg.checkDominance(&use)) {
+        _.sortIdNames();
+        return _.diag(SPV_ERROR_INVALID_ID)
+               << "ID " << _.getIdName(use.id) << " defined in block "
+               << _.getIdName(use.def_block)
+               << " does not dominate its use in block "
+               << _.getIdName(use.use_block);
+      }
+      return SPV_SUCCESS;
+    }
     default:
-      out = [](unsigned) { return false; };
       break;
   }
-  return out;
+  if (!cfg.inFunction() || !cfg.inBlock()) return SPV_SUCCESS;
+
+  for (unsigned i = 0; i < inst->num_operands; i++) {
+    const spv_parsed_operand_t& operand = inst->operands[i];
+    const uint32_t id = inst->words[operand.offset];
+    switch (operand.type) {
+      case SPV_OPERAND_TYPE_RESULT_ID:
+        cfg.addDefinition(id);
+        break;
+      case SPV_OPERAND_TYPE_ID:
+      case SPV_OPERAND_TYPE_TYPE_ID:
+      case SPV_OPERAND_TYPE_MEMORY_SEMANTICS_ID:
+      case SPV_OPERAND_TYPE_SCOPE_ID:
+        if (IsBranchTarget(opcode, i)) {
+          cfg.addSuccessor(id);
+        } else if (SpvOpPhi != opcode || i < 2) {
+          cfg.addUse(id);
+        } else if (i % 2 == 0 && i + 1 < inst->num_operands) {
+          // The operands of an OpPhi are pairs of a value and the label of
+          // the parent block it comes from.
+          cfg.addPhiUse(id, inst->words[inst->operands[i + 1].offset]);
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  cfg.nextInstruction();
+  return SPV_SUCCESS;
 }
 
 // Improves diagnostic messages by collecting names of IDs
@@ -414,15 +518,11 @@ void DebugInstructionPass(ValidationState_t& _,
   switch (inst->opcode) {
     case SpvOpName: {
       const uint32_t target = *(inst->words + inst->operands[0].offset);
-      const char* str =
-          reinterpret_cast<const char*>(inst->words + inst->operands[1].offset);
-      _.assignNameToId(target, str);
+      _.assignNameToId(target, inst->operands[1].offset);
     } break;
     case SpvOpMemberName: {
       const uint32_t target = *(inst->words + inst->operands[0].offset);
-      const char* str =
-          reinterpret_cast<const char*>(inst->words + inst->operands[2].offset);
-      _.assignNameToId(target, str);
+      _.assignMemberNameToId(target, inst->operands[2].offset);
     } break;
     case SpvOpSourceContinued:
     case SpvOpSource:
@@ -436,10 +536,7 @@ void DebugInstructionPass(ValidationState_t& _,
   }
 }
 
-// TODO(umar): Check MemoryModel is in module
 // TODO(umar): Check OpVariable storage class is not function in module section
-// TODO(umar): Make sure function declarations appear before function
-// definitions
 // TODO(umar): Better error messages
 // NOTE: This function does not handle CFG related validation
 // Performs logical layout validation. See Section 2.4
@@ -448,85 +545,43 @@ spv_result_t ModuleLayoutPass(ValidationState_t& _,
   if (_.is_enabled(SPV_VALIDATE_LAYOUT_BIT)) {
     SpvOp opcode = inst->opcode;
 
-    if (libspirv::ModuleLayoutSection::kModule == _.getLayoutStage()) {
-      // Module scoped instructions are processed by determining if the opcode
-      // is part of the current stage. If it is not then the next stage is
-      // checked.
-      while (_.isOpcodeInCurrentLayoutStage(opcode) == false) {
-        // TODO(umar): Check if the MemoryModel instruction has executed
-        _.progressToNextLayoutStageOrder();
-        if (_.getLayoutStage() == libspirv::ModuleLayoutSection::kFunction) {
-          // All module stages have been processed. Recursivly call
-          // ModuleLayoutPass
-          // to process the next section of the module
-          return ModuleLayoutPass(_, inst);
-        }
+    // Module scoped instructions must appear in the order of their sections.
+    // The first instruction which does not ends the module scoped part of
+    // the module, and is validated as part of the function section.
+    if (libspirv::ModuleLayoutSection::kModule == _.getLayoutStage() &&
+        libspirv::ModuleLayoutSection::kModule ==
+            _.progressToLayoutStageOf(opcode)) {
+      return SPV_SUCCESS;
+    }
+
+    // Validate the function layout.
+    switch (opcode) {
+      case SpvOpVariable: {
+        const uint32_t* storage_class = inst->words + inst->operands[2].offset;
+        if (*storage_class != SpvStorageClassFunction)
+          return _.diag(SPV_ERROR_INVALID_LAYOUT)
+                 << "All OpVariable instructions in a function must have a "
+                    "storage class of Function[7]";
+        break;
       }
-    } else {
-      // Validate the function layout.
-      switch (opcode) {
-        case SpvOpCapability:
-        case SpvOpExtension:
-        case SpvOpExtInstImport:
-        case SpvOpMemoryModel:
-        case SpvOpEntryPoint:
-        case SpvOpExecutionMode:
-        case SpvOpSourceContinued:
-        case SpvOpSource:
-        case SpvOpSourceExtension:
-        case SpvOpString:
-        case SpvOpName:
-        case SpvOpMemberName:
-        case SpvOpDecorate:
-        case SpvOpMemberDecorate:
-        case SpvOpGroupDecorate:
-        case SpvOpGroupMemberDecorate:
-        case SpvOpDecorationGroup:
-        case SpvOpTypeVoid:
-        case SpvOpTypeBool:
-        case SpvOpTypeInt:
-        case SpvOpTypeFloat:
-        case SpvOpTypeVector:
-        case SpvOpTypeMatrix:
-        case SpvOpTypeImage:
-        case SpvOpTypeSampler:
-        case SpvOpTypeSampledImage:
-        case SpvOpTypeArray:
-        case SpvOpTypeRuntimeArray:
-        case SpvOpTypeStruct:
-        case SpvOpTypeOpaque:
-        case SpvOpTypePointer:
-        case SpvOpTypeFunction:
-        case SpvOpTypeEvent:
-        case SpvOpTypeDeviceEvent:
-        case SpvOpTypeReserveId:
-        case SpvOpTypeQueue:
-        case SpvOpTypePipe:
-        case SpvOpTypeForwardPointer:
-        case SpvOpConstantTrue:
-        case SpvOpConstantFalse:
-        case SpvOpConstant:
-        case SpvOpConstantComposite:
-        case SpvOpConstantSampler:
-        case SpvOpConstantNull:
-        case SpvOpSpecConstantTrue:
-        case SpvOpSpecConstantFalse:
-        case SpvOpSpecConstant:
-        case SpvOpSpecConstantComposite:
-        case SpvOpSpecConstantOp:
+      case SpvOpLine:
+        break;
+      case SpvOpFunction:
+        _.beginFunction();
+        break;
+      case SpvOpLabel:
+        _.beginFunctionBody();
+        break;
+      case SpvOpFunctionEnd:
+        if (!_.endFunction())
+          return _.diag(SPV_ERROR_INVALID_LAYOUT)
+                 << "Function declarations must appear before function "
+                    "definitions.";
+        break;
+      default:
+        if (libspirv::IsModuleScopeOpcode(opcode))
           return _.diag(SPV_ERROR_INVALID_LAYOUT) << "Invalid Layout";
-        case SpvOpVariable: {
-          const uint32_t* storage_class =
-              inst->words + inst->operands[2].offset;
-          if (*storage_class != SpvStorageClassFunction)
-            return _.diag(SPV_ERROR_INVALID_LAYOUT)
-                   << "All OpVariable instructions in a function must have a "
-                      "storage class of Function[7]";
-          break;
-        }
-        default:
-          return SPV_SUCCESS;
-      }
+        break;
     }
   }
   return SPV_SUCCESS;
@@ -542,10 +597,8 @@ spv_result_t ModuleLayoutPass(ValidationState_t& _,
 spv_result_t ProcessInstructions(void* user_data,
                                  const spv_parsed_instruction_t* inst) {
   ValidationState_t& _ = *(reinterpret_cast<ValidationState_t*>(user_data));
-  _.incrementInstructionCount();
-
-  auto can_have_forward_declared_ids =
-      getCanBeForwardDeclaredFunction(inst->opcode);
+  _.beginInstruction(inst);
+  if (_.is_enabled(SPV_VALIDATE_ID_BIT)) _.recordInstruction(inst);
 
   DebugInstructionPass(_, inst);
 
@@ -553,16 +606,26 @@ spv_result_t ProcessInstructions(void* user_data,
   // TODO(umar): Perform data rules pass
   // TODO(umar): Perform instruction validation pass
   CHECK_RESULT(ModuleLayoutPass(_, inst))
-  CHECK_RESULT(SsaPass(_, can_have_forward_declared_ids, inst))
+  CHECK_RESULT(SsaPass(_, inst))
+  CHECK_RESULT(DominancePass(_, inst))
 
   return SPV_SUCCESS;
 }
 
 } // anonymous namespace
 
-spv_result_t spvValidate(const spv_const_context context,
-                         const spv_const_binary binary, const uint32_t options,
-                         spv_diagnostic* pDiagnostic) {
+namespace {
+
+// Validates the binary as spvValidate does, checking IDs on threadCount
+// threads.  The state and the host byte order copy of the words are kept in
+// vstate and native_words, whose previous contents are discarded but whose
+// storage is reused.
+spv_result_t ValidateBinary(const spv_const_context context,
+                            const spv_const_binary binary,
+                            const uint32_t options, const uint32_t threadCount,
+                            ValidationState_t* vstate,
+                            vector<uint32_t>* native_words,
+                            spv_diagnostic* pDiagnostic) {
   if (!pDiagnostic) return SPV_ERROR_INVALID_DIAGNOSTIC;
 
   spv_endianness_t endian;
@@ -578,54 +641,130 @@ spv_result_t spvValidate(const spv_const_context context,
     return SPV_ERROR_INVALID_BINARY;
   }
 
+  // NOTE: The ID checks refer to the words of each instruction after the
+  // parse, so if the module is not in host byte order, parse a converted
+  // copy.  Otherwise the instructions are used in place.
+  const bool convert = spvIsInBitfield(SPV_VALIDATE_ID_BIT, options) &&
+                       !spvIsHostEndian(endian);
+  if (convert) {
+    native_words->clear();
+    native_words->reserve(binary->wordCount);
+    for (size_t i = 0; i < binary->wordCount; ++i) {
+      native_words->push_back(spvFixWord(binary->code[i], endian));
+    }
+  }
+  const uint32_t* const words = convert ? native_words->data() : binary->code;
+
   // NOTE: Parse the module and perform inline validation checks. These
   // checks do not require the the knowledge of the whole module.
-  ValidationState_t vstate(pDiagnostic, options);
-  auto err = spvBinaryParse(context, &vstate, binary->code, binary->wordCount,
+  vstate->reset(pDiagnostic, options);
+  vstate->setIdBound(header.bound, binary->wordCount);
+  vstate->setModuleWords(binary->code, binary->wordCount, endian);
+  auto err = spvBinaryParse(context, vstate, words, binary->wordCount,
                             setHeader, ProcessInstructions, pDiagnostic);
 
   if (err) {
     return err;
   }
+  vstate->sortIdNames();
 
   // TODO(umar): Add validation checks which require the parsing of the entire
   // module. Use the information from the processInstructions pass to make
   // the checks.
 
-  if (vstate.unresolvedForwardIdCount() > 0) {
+  if (spvIsInBitfield(SPV_VALIDATE_LAYOUT_BIT, options) &&
+      !vstate->hasMemoryModel()) {
+    return vstate->diag(SPV_ERROR_INVALID_LAYOUT)
+           << "Missing required OpMemoryModel instruction.";
+  }
+
+  if (vstate->unresolvedForwardIdCount() > 0) {
     stringstream ss;
-    vector<uint32_t> ids = vstate.unresolvedForwardIds();
+    vector<uint32_t> ids = vstate->unresolvedForwardIds();
 
     transform(begin(ids), end(ids), ostream_iterator<string>(ss, " "),
-              bind(&ValidationState_t::getIdName, vstate, _1));
+              bind(&ValidationState_t::getIdName, std::cref(*vstate), _1));
 
     auto id_str = ss.str();
-    return vstate.diag(SPV_ERROR_INVALID_ID)
+    return vstate->diag(SPV_ERROR_INVALID_ID)
            << "The following forward referenced IDs have not be defined:\n"
            << id_str.substr(0, id_str.size() - 1);
   }
 
-  // NOTE: Copy each instruction for easier processing
-  std::vector<spv_instruction_t> instructions;
-  uint64_t index = SPV_INDEX_INSTRUCTION;
-  while (index < binary->wordCount) {
-    uint16_t wordCount;
-    SpvOp opcode;
-    spvOpcodeSplit(spvFixWord(binary->code[index], endian), &wordCount,
-                   &opcode);
-    spv_instruction_t inst;
-    spvInstructionCopy(&binary->code[index], opcode, wordCount, endian, &inst);
-    instructions.push_back(inst);
-    index += wordCount;
-  }
-
   if (spvIsInBitfield(SPV_VALIDATE_ID_BIT, options)) {
     position.index = SPV_INDEX_INSTRUCTION;
-    spvCheckReturn(
-        spvValidateIDs(instructions.data(), instructions.size(), header.bound,
-                       context->opcode_table, context->operand_table,
-                       context->ext_inst_table, &position, pDiagnostic));
+    const auto& instructions = vstate->instructions();
+    const auto& idDefs = vstate->idDefs();
+    const auto& idUses = vstate->idUses();
+    spvCheckReturn(spvValidateIDs(
+        instructions.data(), instructions.size(), idUses.data(), idUses.size(),
+        idDefs.data(), idDefs.size(), header.bound, context->opcode_table,
+        context->operand_table, context->ext_inst_table, threadCount,
+        &position, pDiagnostic));
+  }
+
+  return SPV_SUCCESS;
+}
+
+// Returns the number of threads on which to check the IDs of a module.
+uint32_t IdThreadCount(const uint32_t options) {
+  return spvIsInBitfield(SPV_VALIDATE_PARALLEL_BIT, options)
+             ? std::max(1u, std::thread::hardware_concurrency())
+             : 1;
+}
+
+}  // anonymous namespace
+
+spv_result_t spvValidate(const spv_const_context context,
+                         const spv_const_binary binary, const uint32_t options,
+                         spv_diagnostic* pDiagnostic) {
+  ValidationState_t vstate(pDiagnostic, options);
+  vector<uint32_t> native_words;
+  return ValidateBinary(context, binary, options, IdThreadCount(options),
+                        &vstate, &native_words, pDiagnostic);
+}
+
+spv_result_t spvValidateBatch(const spv_const_context context,
+                              const spv_const_binary* binaries,
+                              const size_t count, const uint32_t options,
+                              const uint32_t threadCount,
+                              spv_result_t* results,
+                              spv_diagnostic* diagnostics) {
+  if (!count) return SPV_SUCCESS;
+  if (!diagnostics) return SPV_ERROR_INVALID_DIAGNOSTIC;
+  if (!binaries || !results) return SPV_ERROR_INVALID_POINTER;
+
+  const size_t workerCount = std::min<size_t>(
+      threadCount ? threadCount
+                  : std::max(1u, std::thread::hardware_concurrency()),
+      count);
+  // NOTE: Once the modules are spread over several threads, checking the IDs
+  // of each one on more threads would only oversubscribe the cores.
+  const uint32_t idThreadCount = workerCount > 1 ? 1 : IdThreadCount(options);
+
+  // Each worker validates the next module which has not been taken, reusing
+  // its state for all of them.  The grammar tables of the context are only
+  // read, so they are shared.
+  std::atomic<size_t> next(0);
+  auto validate = [&]() {
+    ValidationState_t vstate(nullptr, options);
+    vector<uint32_t> native_words;
+    for (size_t index = next++; index < count; index = next++) {
+      results[index] =
+          ValidateBinary(context, binaries[index], options, idThreadCount,
+                         &vstate, &native_words, &diagnostics[index]);
+    }
+  };
+
+  vector<std::thread> threads;
+  for (size_t helper = 1; helper < workerCount; ++helper) {
+    threads.emplace_back(validate);
   }
+  validate();
+  for (auto& thread : threads) thread.join();
 
+  for (size_t index = 0; index < count; ++index) {
+    if (results[index]) return results[index];
+  }
   return SPV_SUCCESS;
 }
@@ -36,7 +36,7 @@
 typedef struct spv_id_info_t {
   uint32_t id;
   SpvOp opcode;
-  const spv_instruction_t* inst;
+  const spv_instruction_view_t* inst;
   spv_position_t position;
 } spv_id_info_t;
 
@@ -50,36 +50,47 @@ typedef struct spv_id_info_t {
 /// @param[in] idUsesCount number of ID uses
 /// @param[in] pIdDefs stream of ID uses
 /// @param[in] idDefsCount number of ID uses
+/// @param[in] bound the ID bound from the binary header
 /// @param[in] opcodeTable table of specified Opcodes
 /// @param[in] operandTable table of specified operands
+/// @param[in] threadCount number of threads checking functions, at least 1
 /// @param[in,out] position current position in the stream
 /// @param[out] pDiag contains diagnostic on failure
 ///
 /// @return result code
 spv_result_t spvValidateInstructionIDs(
-    const spv_instruction_t* pInsts, const uint64_t instCount,
+    const spv_instruction_view_t* pInsts, const uint64_t instCount,
     const spv_id_info_t* pIdUses, const uint64_t idUsesCount,
     const spv_id_info_t* pIdDefs, const uint64_t idDefsCount,
-    const spv_opcode_table opcodeTable, const spv_operand_table operandTable,
-    const spv_ext_inst_table extInstTable, spv_position position,
-    spv_diagnostic* pDiag);
+    const uint32_t bound, const spv_opcode_table opcodeTable,
+    const spv_operand_table operandTable, const spv_ext_inst_table extInstTable,
+    const uint32_t threadCount, spv_position position, spv_diagnostic* pDiag);
 
 /// @brief Validate the ID's within a SPIR-V binary
 ///
 /// @param[in] pInstructions array of instructions
 /// @param[in] count number of elements in instruction array
-/// @param[in] bound the binary header
+/// @param[in] pIdUses uses of IDs, in module order
+/// @param[in] idUsesCount number of ID uses
+/// @param[in] pIdDefs definitions of IDs, in module order
+/// @param[in] idDefsCount number of ID definitions
+/// @param[in] bound the ID bound from the binary header
 /// @param[in] opcodeTable table of specified Opcodes
 /// @param[in] operandTable table of specified operands
+/// @param[in] threadCount number of threads checking functions, at least 1
 /// @param[in,out] position current word in the binary
 /// @param[out] pDiagnostic contains diagnostic on failure
 ///
 /// @return result code
-spv_result_t spvValidateIDs(const spv_instruction_t* pInstructions,
-                            const uint64_t count, const uint32_t bound,
+spv_result_t spvValidateIDs(const spv_instruction_view_t* pInstructions,
+                            const uint64_t count, const spv_id_info_t* pIdUses,
+                            const uint64_t idUsesCount,
+                            const spv_id_info_t* pIdDefs,
+                            const uint64_t idDefsCount, const uint32_t bound,
                             const spv_opcode_table opcodeTable,
                             const spv_operand_table operandTable,
                             const spv_ext_inst_table extInstTable,
-                            spv_position position, spv_diagnostic* pDiagnostic);
+                            const uint32_t threadCount, spv_position position,
+                            spv_diagnostic* pDiagnostic);
 
 #endif  // LIBSPIRV_VALIDATE_H_
@@ -0,0 +1,294 @@
+// Copyright (c) 2016 The Khronos Group Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and/or associated documentation files (the
+// "Materials"), to deal in the Materials without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Materials, and to
+// permit persons to whom the Materials are furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Materials.
+//
+// MODIFICATIONS TO THIS FILE MAY MEAN IT NO LONGER ACCURATELY REFLECTS
+// KHRONOS STANDARDS. THE UNMODIFIED, NORMATIVE VERSIONS OF KHRONOS
+// SPECIFICATIONS AND HEADER INFORMATION ARE LOCATED AT
+//    https://www.khronos.org/registry/
+//
+// THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+
+
+#include "validate_cfg.h"
+
+#include <utility>
+#include <vector>
+
+using std::pair;
+using std::vector;
+
+namespace libspirv {
+
+const uint32_t DominatorTree::kUnreachable;
+const uint32_t FunctionCfg::kParameter;
+
+DominatorTree::DominatorTree(const vector<uint32_t>& successor_offsets,
+                             const vector<uint32_t>& successors)
+    : idom_(), preorder_(), postorder_() {
+  const uint32_t num_blocks =
+      static_cast<uint32_t>(successor_offsets.size()) - 1;
+  idom_.assign(num_blocks, kUnreachable);
+  preorder_.assign(num_blocks, kUnreachable);
+  postorder_.assign(num_blocks, kUnreachable);
+  if (num_blocks == 0) return;
+
+  // Number the reachable blocks in depth-first order from the entry.  The
+  // rest of the algorithm works on these numbers.
+  const uint32_t kNone = kUnreachable;
+  vector<uint32_t> number(num_blocks, kNone);
+  vector<uint32_t> block;
+  vector<uint32_t> parent;
+  {
+    // Each entry is a block and the position of its next successor.
+    vector<pair<uint32_t, uint32_t>> stack;
+    number[0] = 0;
+    block.push_back(0);
+    parent.push_back(kNone);
+    stack.push_back({0, successor_offsets[0]});
+    while (!stack.empty()) {
+      const uint32_t b = stack.back().first;
+      const uint32_t next = stack.back().second;
+      if (next == successor_offsets[b + 1]) {
+        stack.pop_back();
+        continue;
+      }
+      ++stack.back().second;
+      const uint32_t s = successors[next];
+      if (number[s] != kNone) continue;
+      number[s] = static_cast<uint32_t>(block.size());
+      block.push_back(s);
+      parent.push_back(number[b]);
+      stack.push_back({s, successor_offsets[s]});
+    }
+  }
+  const uint32_t num_reachable = static_cast<uint32_t>(block.size());
+
+  // The reachable predecessors of each reachable block.
+  vector<uint32_t> pred_offsets(num_reachable + 1, 0);
+  for (uint32_t v = 0; v < num_reachable; ++v) {
+    for (uint32_t i = successor_offsets[block[v]];
+         i < successor_offsets[block[v] + 1]; ++i) {
+      ++pred_offsets[number[successors[i]] + 1];
+    }
+  }
+  for (uint32_t v = 0; v < num_reachable; ++v) {
+    pred_offsets[v + 1] += pred_offsets[v];
+  }
+  vector<uint32_t> preds(pred_offsets[num_reachable]);
+  {
+    vector<uint32_t> fill(pred_offsets.begin(), pred_offsets.end() - 1);
+    for (uint32_t v = 0; v < num_reachable; ++v) {
+      for (uint32_t i = successor_offsets[block[v]];
+           i < successor_offsets[block[v] + 1]; ++i) {
+        preds[fill[number[successors[i]]]++] = v;
+      }
+    }
+  }
+
+  // Lengauer-Tarjan, with simple path compression.  The blocks whose
+  // semidominator is v are kept in a list through bucket_head[v] and
+  // bucket_next.
+  vector<uint32_t> semi(num_reachable);
+  vector<uint32_t> label(num_reachable);
+  vector<uint32_t> ancestor(num_reachable, kNone);
+  vector<uint32_t> idom(num_reachable, 0);
+  vector<uint32_t> bucket_head(num_reachable, kNone);
+  vector<uint32_t> bucket_next(num_reachable, kNone);
+  for (uint32_t v = 0; v < num_reachable; ++v) semi[v] = label[v] = v;
+
+  vector<uint32_t> path;
+  auto eval = [&](uint32_t v) -> uint32_t {
+    if (ancestor[v] == kNone) return v;
+    // Compress the path from v to the root of its tree, from the top down.
+    path.clear();
+    for (uint32_t u = v; ancestor[ancestor[u]] != kNone; u = ancestor[u]) {
+      path.push_back(u);
+    }
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+      const uint32_t u = *it;
+      const uint32_t a = ancestor[u];
+      if (semi[label[a]] < semi[label[u]]) label[u] = label[a];
+      ancestor[u] = ancestor[a];
+    }
+    return label[v];
+  };
+
+  for (uint32_t w = num_reachable - 1; w > 0; --w) {
+    for (uint32_t i = pred_offsets[w]; i < pred_offsets[w + 1]; ++i) {
+      const uint32_t u = eval(preds[i]);
+      if (semi[u] < semi[w]) semi[w] = semi[u];
+    }
+    bucket_next[w] = bucket_head[semi[w]];
+    bucket_head[semi[w]] = w;
+    const uint32_t p = parent[w];
+    ancestor[w] = p;
+    for (uint32_t v = bucket_head[p]; v != kNone; v = bucket_next[v]) {
+      const uint32_t u = eval(v);
+      idom[v] = semi[u] < semi[v] ? u : p;
+    }
+    bucket_head[p] = kNone;
+  }
+  for (uint32_t w = 1; w < num_reachable; ++w) {
+    if (idom[w] != semi[w]) idom[w] = idom[idom[w]];
+  }
+
+  // Number the blocks in preorder and postorder over the dominator tree, so
+  // that dominance is a pair of comparisons.
+  vector<uint32_t> child_offsets(num_reachable + 1, 0);
+  for (uint32_t v = 1; v < num_reachable; ++v) ++child_offsets[idom[v] + 1];
+  for (uint32_t v = 0; v < num_reachable; ++v) {
+    child_offsets[v + 1] += child_offsets[v];
+  }
+  vector<uint32_t> children(child_offsets[num_reachable]);
+  {
+    vector<uint32_t> fill(child_offsets.begin(), child_offsets.end() - 1);
+    for (uint32_t v = 1; v < num_reachable; ++v) {
+      children[fill[idom[v]]++] = v;
+    }
+  }
+  uint32_t pre = 0;
+  uint32_t post = 0;
+  vector<pair<uint32_t, uint32_t>> stack;
+  preorder_[block[0]] = pre++;
+  stack.push_back({0, child_offsets[0]});
+  while (!stack.empty()) {
+    const uint32_t v = stack.back().first;
+    const uint32_t next = stack.back().second;
+    if (next == child_offsets[v + 1]) {
+      postorder_[block[v]] = post++;
+      stack.pop_back();
+      continue;
+    }
+    ++stack.back().second;
+    const uint32_t c = children[next];
+    preorder_[block[c]] = pre++;
+    stack.push_back({c, child_offsets[c]});
+  }
+
+  for (uint32_t v = 1; v < num_reachable; ++v) {
+    idom_[block[v]] = block[idom[v]];
+  }
+}
+
+FunctionCfg::FunctionCfg()
+    : in_function_(false),
+      instruction_(0),
+      block_labels_(),
+      block_indices_(),
+      successor_offsets_(),
+      successor_labels_(),
+      definitions_(),
+      uses_() {}
+
+void FunctionCfg::beginFunction() {
+  in_function_ = true;
+  instruction_ = 0;
+  block_labels_.clear();
+  block_indices_.clear();
+  successor_offsets_.clear();
+  successor_labels_.clear();
+  definitions_.clear();
+  uses_.clear();
+}
+
+void FunctionCfg::addParameter(uint32_t id) {
+  definitions_[id] = {kParameter, 0};
+}
+
+void FunctionCfg::beginBlock(uint32_t label) {
+  block_indices_[label] = static_cast<uint32_t>(block_labels_.size());
+  block_labels_.push_back(label);
+  successor_offsets_.push_back(static_cast<uint32_t>(successor_labels_.size()));
+  instruction_ = 0;
+}
+
+void FunctionCfg::addSuccessor(uint32_t label) {
+  successor_labels_.push_back(label);
+}
+
+void FunctionCfg::addDefinition(uint32_t id) {
+  const uint32_t block = static_cast<uint32_t>(block_labels_.size()) - 1;
+  definitions_[id] = {block, instruction_};
+}
+
+void FunctionCfg::addUse(uint32_t id) {
+  const uint32_t block = static_cast<uint32_t>(block_labels_.size()) - 1;
+  uses_.push_back({id, block, instruction_, 0});
+}
+
+void FunctionCfg::addPhiUse(uint32_t id, uint32_t parent_label) {
+  const uint32_t block = static_cast<uint32_t>(block_labels_.size()) - 1;
+  uses_.push_back({id, block, instruction_, parent_label});
+}
+
+void FunctionCfg::endFunction() { in_function_ = false; }
+
+bool FunctionCfg::checkDominance(UndominatedUse* undominated) const {
+  const uint32_t num_blocks = static_cast<uint32_t>(block_labels_.size());
+  if (num_blocks == 0) return true;
+
+  // Resolve the labels of the successors of each block.  Labels which are
+  // not in the function are left to other checks.
+  vector<uint32_t> offsets;
+  vector<uint32_t> successors;
+  offsets.reserve(num_blocks + 1);
+  successors.reserve(successor_labels_.size());
+  for (uint32_t b = 0; b < num_blocks; ++b) {
+    offsets.push_back(static_cast<uint32_t>(successors.size()));
+    const size_t end = b + 1 < num_blocks ? successor_offsets_[b + 1]
+                                          : successor_labels_.size();
+    for (size_t i = successor_offsets_[b]; i < end; ++i) {
+      const auto found = block_indices_.find(successor_labels_[i]);
+      if (found != block_indices_.end()) successors.push_back(found->second);
+    }
+  }
+  offsets.push_back(static_cast<uint32_t>(successors.size()));
+  const DominatorTree tree(offsets, successors);
+
+  for (const Use& use : uses_) {
+    const auto found = definitions_.find(use.id);
+    if (found == definitions_.end()) continue;
+    const Definition& def = found->second;
+    if (def.block == kParameter) continue;
+
+    uint32_t use_block = use.block;
+    bool dominated = false;
+    if (use.phi_parent) {
+      // An OpPhi uses each value at the end of its parent block.
+      const auto parent = block_indices_.find(use.phi_parent);
+      if (parent == block_indices_.end()) continue;
+      use_block = parent->second;
+      if (!tree.isReachable(use_block)) continue;
+      dominated = tree.dominates(def.block, use_block);
+    } else {
+      if (!tree.isReachable(use_block)) continue;
+      dominated = def.block == use_block
+                      ? def.instruction < use.instruction
+                      : tree.dominates(def.block, use_block);
+    }
+    if (!dominated) {
+      *undominated = {use.id, block_labels_[def.block],
+                      block_labels_[use_block]};
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace libspirv
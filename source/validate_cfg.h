@@ -0,0 +1,170 @@
+// Copyright (c) 2016 The Khronos Group Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and/or associated documentation files (the
+// "Materials"), to deal in the Materials without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Materials, and to
+// permit persons to whom the Materials are furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Materials.
+//
+// MODIFICATIONS TO THIS FILE MAY MEAN IT NO LONGER ACCURATELY REFLECTS
+// KHRONOS STANDARDS. THE UNMODIFIED, NORMATIVE VERSIONS OF KHRONOS
+// SPECIFICATIONS AND HEADER INFORMATION ARE LOCATED AT
+//    https://www.khronos.org/registry/
+//
+// THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+
+
+#ifndef LIBSPIRV_VALIDATE_CFG_H_
+#define LIBSPIRV_VALIDATE_CFG_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace libspirv {
+
+// The dominator tree of a control flow graph.  The blocks of the graph are
+// numbered from 0, with block 0 as the entry, and the successors of block b
+// are successors[successor_offsets[b]] up to
+// successors[successor_offsets[b + 1]].
+//
+// The tree is built with the Lengauer-Tarjan algorithm, in O(E log V) time,
+// without recursion so that deep graphs do not overflow the stack.
+class DominatorTree {
+ public:
+  DominatorTree(const std::vector<uint32_t>& successor_offsets,
+                const std::vector<uint32_t>& successors);
+
+  // Returns true if the block is reachable from the entry block.
+  bool isReachable(uint32_t block) const {
+    return preorder_[block] != kUnreachable;
+  }
+
+  // Returns the immediate dominator of a reachable block other than the
+  // entry block.
+  uint32_t immediateDominator(uint32_t block) const { return idom_[block]; }
+
+  // Returns true if block a dominates block b.  Each block dominates itself,
+  // and an unreachable block dominates nothing.
+  bool dominates(uint32_t a, uint32_t b) const {
+    return isReachable(a) && isReachable(b) && preorder_[a] <= preorder_[b] &&
+           postorder_[b] <= postorder_[a];
+  }
+
+ private:
+  static const uint32_t kUnreachable = UINT32_MAX;
+
+  // The immediate dominator of each block
+  std::vector<uint32_t> idom_;
+  // The preorder and postorder numbers of each block in the dominator tree,
+  // or kUnreachable
+  std::vector<uint32_t> preorder_;
+  std::vector<uint32_t> postorder_;
+};
+
+// Records the control flow graph of a function, and the definitions and uses
+// of the IDs in it, to check that each definition dominates its uses.
+class FunctionCfg {
+ public:
+  FunctionCfg();
+
+  // Starts recording a function.
+  void beginFunction();
+
+  // Returns true between beginFunction and endFunction.
+  bool inFunction() const { return in_function_; }
+
+  // Records a parameter of the function, which dominates the whole function.
+  void addParameter(uint32_t id);
+
+  // Starts recording the block with the given label.
+  void beginBlock(uint32_t label);
+
+  // Returns true if a block is being recorded.
+  bool inBlock() const { return !block_labels_.empty(); }
+
+  // Records a branch from the current block to the block with the label.
+  void addSuccessor(uint32_t label);
+
+  // Records the definition of an ID by the current instruction.
+  void addDefinition(uint32_t id);
+
+  // Records the use of an ID by the current instruction.
+  void addUse(uint32_t id);
+
+  // Records the use of an ID by an OpPhi, as the value from the parent block
+  // with the given label.
+  void addPhiUse(uint32_t id, uint32_t parent_label);
+
+  // Moves on to the next instruction of the current block.
+  void nextInstruction() { ++instruction_; }
+
+  // Stops recording the function.
+  void endFunction();
+
+  // An ID used where its definition does not dominate the use.
+  struct UndominatedUse {
+    uint32_t id;
+    // The labels of the blocks of the definition and the use
+    uint32_t def_block;
+    uint32_t use_block;
+  };
+
+  // Checks that the definition of each ID recorded in the function dominates
+  // its uses.  Uses of IDs which are not defined in the function, and uses in
+  // unreachable blocks, are not checked.  Returns false and describes the
+  // first undominated use in *use if there is one.
+  bool checkDominance(UndominatedUse* use) const;
+
+ private:
+  // Where an ID is defined
+  struct Definition {
+    // The index of the block, or kParameter
+    uint32_t block;
+    // The index of the instruction within the block
+    uint32_t instruction;
+  };
+
+  // Where an ID is used
+  struct Use {
+    uint32_t id;
+    uint32_t block;
+    uint32_t instruction;
+    // The label of the parent block of an OpPhi value, otherwise 0
+    uint32_t phi_parent;
+  };
+
+  static const uint32_t kParameter = UINT32_MAX;
+
+  bool in_function_;
+  // The index of the current instruction within the current block
+  uint32_t instruction_;
+
+  // The label of each block, and the index of the block with each label
+  std::vector<uint32_t> block_labels_;
+  std::unordered_map<uint32_t, uint32_t> block_indices_;
+
+  // The labels of the successors of each block, in blocks of the flat array
+  // starting at successor_offsets_[block]
+  std::vector<uint32_t> successor_offsets_;
+  std::vector<uint32_t> successor_labels_;
+
+  std::unordered_map<uint32_t, Definition> definitions_;
+  std::vector<Use> uses_;
+};
+
+}  // namespace libspirv
+
+#endif  // LIBSPIRV_VALIDATE_CFG_H_
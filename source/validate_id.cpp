@@ -26,10 +26,15 @@
 
 #include <assert.h>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <unordered_map>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include "binary.h"
 #include "diagnostic.h"
 #include "instruction.h"
 #include "libspirv/libspirv.h"
@@ -42,79 +47,162 @@
   }
 
 namespace {
+// The uses of an ID, in module order.
+class idUseList {
+ public:
+  idUseList(const spv_id_info_t* const* beginArg,
+            const spv_id_info_t* const* endArg)
+      : first(beginArg), last(endArg) {}
+  const spv_id_info_t* const* begin() const { return first; }
+  const spv_id_info_t* const* end() const { return last; }
+  bool empty() const { return first == last; }
+
+ private:
+  const spv_id_info_t* const* first;
+  const spv_id_info_t* const* last;
+};
+
+// The definition and uses of each ID of a module.
+class idIndex {
+ public:
+  idIndex(const spv_id_info_t* pIdUses, const uint64_t idUsesCount,
+          const spv_id_info_t* pIdDefs, const uint64_t idDefsCount,
+          const spv_instruction_view_t* pInsts, const uint64_t instCount,
+          const uint32_t bound)
+      : denseIds(false), slotCount(0) {
+    // Index the IDs directly if the bound allows it and covers every ID.
+    uint64_t wordCount = 0;
+    for (uint64_t instIndex = 0; instIndex < instCount; ++instIndex) {
+      wordCount += pInsts[instIndex].words.size();
+    }
+    uint32_t maxId = 0;
+    for (uint64_t idUsesIndex = 0; idUsesIndex < idUsesCount; ++idUsesIndex) {
+      maxId = std::max(maxId, pIdUses[idUsesIndex].id);
+    }
+    for (uint64_t idDefsIndex = 0; idDefsIndex < idDefsCount; ++idDefsIndex) {
+      maxId = std::max(maxId, pIdDefs[idDefsIndex].id);
+    }
+    if (spvDenseIdBound(bound, size_t(wordCount)) && maxId <= bound) {
+      denseIds = true;
+      slotCount = uint64_t(bound) + 1;
+      idDefs.assign(slotCount, nullptr);
+    }
+
+    // The definition of each ID.  If an ID is defined more than once, the
+    // last definition wins.
+    for (uint64_t idDefsIndex = 0; idDefsIndex < idDefsCount; ++idDefsIndex) {
+      const uint32_t slot = addSlot(pIdDefs[idDefsIndex].id);
+      if (idDefs.size() <= slot) idDefs.resize(slot + 1, nullptr);
+      idDefs[slot] = &pIdDefs[idDefsIndex];
+    }
+
+    // Pack the uses of all IDs into one array, grouped by ID.  The uses of
+    // the ID in slot S are idUses[idUseOffsets[S]] up to, but not including,
+    // idUses[idUseOffsets[S + 1]].
+    std::vector<uint32_t> useSlots(idUsesCount);
+    for (uint64_t idUsesIndex = 0; idUsesIndex < idUsesCount; ++idUsesIndex) {
+      useSlots[idUsesIndex] = addSlot(pIdUses[idUsesIndex].id);
+    }
+    idDefs.resize(slotCount, nullptr);
+    idUseOffsets.assign(slotCount + 1, 0);
+    for (const uint32_t slot : useSlots) ++idUseOffsets[slot + 1];
+    for (uint64_t slot = 0; slot < slotCount; ++slot) {
+      idUseOffsets[slot + 1] += idUseOffsets[slot];
+    }
+    idUses.resize(idUsesCount);
+    std::vector<uint64_t> nextUse(idUseOffsets.begin(), idUseOffsets.end() - 1);
+    for (uint64_t idUsesIndex = 0; idUsesIndex < idUsesCount; ++idUsesIndex) {
+      idUses[nextUse[useSlots[idUsesIndex]]++] = &pIdUses[idUsesIndex];
+    }
+  }
+
+  // Returns the definition of the ID, or nullptr if it is not defined.
+  const spv_id_info_t* find(const uint32_t& id) const {
+    const uint64_t slot = findSlot(id);
+    return slot < idDefs.size() ? idDefs[slot] : nullptr;
+  }
+
+  // Returns the uses of the ID.
+  idUseList findUses(const uint32_t& id) const {
+    const uint64_t slot = findSlot(id);
+    if (slotCount <= slot) return idUseList(nullptr, nullptr);
+    const spv_id_info_t* const* uses = idUses.data();
+    return idUseList(uses + idUseOffsets[slot], uses + idUseOffsets[slot + 1]);
+  }
+
+ private:
+  // Returns the slot of the ID in the def/use index, allocating one if the
+  // IDs are not indexed directly.
+  uint32_t addSlot(uint32_t id) {
+    if (denseIds) return id;
+    auto inserted = sparseSlots.insert(std::make_pair(id, uint32_t(slotCount)));
+    if (inserted.second) ++slotCount;
+    return inserted.first->second;
+  }
+
+  // Returns the slot of the ID in the def/use index, or slotCount if the ID
+  // has no slot.
+  uint64_t findSlot(uint32_t id) const {
+    if (denseIds) return id < slotCount ? id : slotCount;
+    auto item = sparseSlots.find(id);
+    return sparseSlots.end() == item ? slotCount : item->second;
+  }
+
+  // Whether IDs are their own slots.  Otherwise slots are assigned to IDs in
+  // order of appearance, through sparseSlots.
+  bool denseIds;
+  uint64_t slotCount;
+  std::unordered_map<uint32_t, uint32_t> sparseSlots;
+  // The definition of the ID in each slot, or nullptr.
+  std::vector<const spv_id_info_t*> idDefs;
+  // The uses of all IDs, grouped by slot, and the start of each group.
+  std::vector<const spv_id_info_t*> idUses;
+  std::vector<uint64_t> idUseOffsets;
+};
+
+// Checks the IDs of instructions against an idIndex, which is only read, so
+// several idUsage objects with their own position and diagnostic may check
+// different instructions of a module at the same time.
 class idUsage {
  public:
   idUsage(const spv_opcode_table opcodeTableArg,
           const spv_operand_table operandTableArg,
-          const spv_ext_inst_table extInstTableArg, const spv_id_info_t* pIdUses,
-          const uint64_t idUsesCount, const spv_id_info_t* pIdDefs,
-          const uint64_t idDefsCount, const spv_instruction_t* pInsts,
-          const uint64_t instCountArg, spv_position positionArg,
-          spv_diagnostic* pDiagnosticArg)
+          const spv_ext_inst_table extInstTableArg, const idIndex& indexArg,
+          const spv_instruction_view_t* pInsts, const uint64_t instCountArg,
+          spv_position positionArg, spv_diagnostic* pDiagnosticArg)
       : opcodeTable(opcodeTableArg),
         operandTable(operandTableArg),
         extInstTable(extInstTableArg),
+        index(indexArg),
         firstInst(pInsts),
         instCount(instCountArg),
         position(positionArg),
-        pDiagnostic(pDiagnosticArg) {
-    for (uint64_t idUsesIndex = 0; idUsesIndex < idUsesCount; ++idUsesIndex) {
-      idUses[pIdUses[idUsesIndex].id].push_back(pIdUses[idUsesIndex]);
-    }
-    for (uint64_t idDefsIndex = 0; idDefsIndex < idDefsCount; ++idDefsIndex) {
-      idDefs[pIdDefs[idDefsIndex].id] = pIdDefs[idDefsIndex];
-    }
-  }
+        pDiagnostic(pDiagnosticArg) {}
 
-  bool isValid(const spv_instruction_t* inst);
+  bool isValid(const spv_instruction_view_t* inst);
 
   template <SpvOp>
-  bool isValid(const spv_instruction_t* inst, const spv_opcode_desc);
+  bool isValid(const spv_instruction_view_t* inst, const spv_opcode_desc);
 
-  std::unordered_map<uint32_t, spv_id_info_t>::iterator find(
-      const uint32_t& id) {
-    return idDefs.find(id);
-  }
-  std::unordered_map<uint32_t, spv_id_info_t>::const_iterator find(
-      const uint32_t& id) const {
-    return idDefs.find(id);
-  }
+  // Returns the definition of the ID, or nullptr if it is not defined.
+  const spv_id_info_t* find(const uint32_t& id) const { return index.find(id); }
 
-  bool found(std::unordered_map<uint32_t, spv_id_info_t>::iterator item) {
-    return idDefs.end() != item;
-  }
-  bool found(std::unordered_map<uint32_t, spv_id_info_t>::const_iterator item) {
-    return idDefs.end() != item;
-  }
+  bool found(const spv_id_info_t* item) const { return nullptr != item; }
 
-  std::unordered_map<uint32_t, std::vector<spv_id_info_t>>::iterator findUses(
-      const uint32_t& id) {
-    return idUses.find(id);
-  }
-  std::unordered_map<uint32_t, std::vector<spv_id_info_t>>::const_iterator
-  findUses(const uint32_t& id) const {
-    return idUses.find(id);
-  }
+  // Returns the uses of the ID.
+  idUseList findUses(const uint32_t& id) const { return index.findUses(id); }
 
-  bool foundUses(
-      std::unordered_map<uint32_t, std::vector<spv_id_info_t>>::iterator item) {
-    return idUses.end() != item;
-  }
-  bool foundUses(std::unordered_map<
-                 uint32_t, std::vector<spv_id_info_t>>::const_iterator item) {
-    return idUses.end() != item;
-  }
+  bool foundUses(const idUseList& item) const { return !item.empty(); }
 
  private:
   const spv_opcode_table opcodeTable;
   const spv_operand_table operandTable;
   const spv_ext_inst_table extInstTable;
-  const spv_instruction_t* const firstInst;
+  const idIndex& index;
+  const spv_instruction_view_t* const firstInst;
   const uint64_t instCount;
   spv_position position;
   spv_diagnostic* pDiagnostic;
-  std::unordered_map<uint32_t, std::vector<spv_id_info_t>> idUses;
-  std::unordered_map<uint32_t, spv_id_info_t> idDefs;
 };
 
 #define DIAG(INDEX)         \
@@ -123,7 +211,7 @@ class idUsage {
 
 #if 0
 template <>
-bool idUsage::isValid<SpvOpUndef>(const spv_instruction_t *inst,
+bool idUsage::isValid<SpvOpUndef>(const spv_instruction_view_t *inst,
                                   const spv_opcode_desc) {
   assert(0 && "Unimplemented!");
   return false;
@@ -131,7 +219,7 @@ bool idUsage::isValid<SpvOpUndef>(const spv_instruction_t *inst,
 #endif
 
 template <>
-bool idUsage::isValid<SpvOpName>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpName>(const spv_instruction_view_t* inst,
                                  const spv_opcode_desc) {
   auto targetIndex = 1;
   auto target = find(inst->words[targetIndex]);
@@ -143,7 +231,7 @@ bool idUsage::isValid<SpvOpName>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpMemberName>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpMemberName>(const spv_instruction_view_t* inst,
                                        const spv_opcode_desc) {
   auto typeIndex = 1;
   auto type = find(inst->words[typeIndex]);
@@ -151,25 +239,25 @@ bool idUsage::isValid<SpvOpMemberName>(const spv_instruction_t* inst,
                                          << inst->words[typeIndex]
                                          << "' is not defined.";
            return false);
-  spvCheck(SpvOpTypeStruct != type->second.opcode,
+  spvCheck(SpvOpTypeStruct != type->opcode,
            DIAG(typeIndex) << "OpMemberName Type <id> '"
                            << inst->words[typeIndex]
                            << "' is not a struct type.";
            return false);
   auto memberIndex = 2;
   auto member = inst->words[memberIndex];
-  auto memberCount = (uint32_t)(type->second.inst->words.size() - 2);
+  auto memberCount = (uint32_t)(type->inst->words.size() - 2);
   spvCheck(memberCount <= member, DIAG(memberIndex)
                                       << "OpMemberName Member <id> '"
                                       << inst->words[memberIndex]
                                       << "' index is larger than Type <id> '"
-                                      << type->second.id << "'s member count.";
+                                      << type->id << "'s member count.";
            return false);
   return true;
 }
 
 template <>
-bool idUsage::isValid<SpvOpLine>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpLine>(const spv_instruction_view_t* inst,
                                  const spv_opcode_desc) {
   auto fileIndex = 1;
   auto file = find(inst->words[fileIndex]);
@@ -177,7 +265,7 @@ bool idUsage::isValid<SpvOpLine>(const spv_instruction_t* inst,
                                          << inst->words[fileIndex]
                                          << "' is not defined.";
            return false);
-  spvCheck(SpvOpString != file->second.opcode,
+  spvCheck(SpvOpString != file->opcode,
            DIAG(fileIndex) << "OpLine Target <id> '" << inst->words[fileIndex]
                            << "' is not an OpString.";
            return false);
@@ -185,7 +273,7 @@ bool idUsage::isValid<SpvOpLine>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpDecorate>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpDecorate>(const spv_instruction_view_t* inst,
                                      const spv_opcode_desc) {
   auto targetIndex = 1;
   auto target = find(inst->words[targetIndex]);
@@ -197,7 +285,7 @@ bool idUsage::isValid<SpvOpDecorate>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpMemberDecorate>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpMemberDecorate>(const spv_instruction_view_t* inst,
                                            const spv_opcode_desc) {
   auto structTypeIndex = 1;
   auto structType = find(inst->words[structTypeIndex]);
@@ -206,14 +294,14 @@ bool idUsage::isValid<SpvOpMemberDecorate>(const spv_instruction_t* inst,
                                    << inst->words[structTypeIndex]
                                    << "' is not defined.";
            return false);
-  spvCheck(SpvOpTypeStruct != structType->second.inst->opcode,
+  spvCheck(SpvOpTypeStruct != structType->inst->opcode,
            DIAG(structTypeIndex) << "OpMemberDecorate Structure type <id> '"
                                  << inst->words[structTypeIndex]
                                  << "' is not a struct type.";
            return false);
   auto memberIndex = 2;
   auto member = inst->words[memberIndex];
-  auto memberCount = (uint32_t)(structType->second.inst->words.size() - 2);
+  auto memberCount = (uint32_t)(structType->inst->words.size() - 2);
   spvCheck(memberCount < member, DIAG(memberIndex)
                                      << "OpMemberDecorate Structure type <id> '"
                                      << inst->words[memberIndex]
@@ -223,7 +311,7 @@ bool idUsage::isValid<SpvOpMemberDecorate>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpGroupDecorate>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpGroupDecorate>(const spv_instruction_view_t* inst,
                                           const spv_opcode_desc) {
   auto decorationGroupIndex = 1;
   auto decorationGroup = find(inst->words[decorationGroupIndex]);
@@ -232,7 +320,7 @@ bool idUsage::isValid<SpvOpGroupDecorate>(const spv_instruction_t* inst,
                << "OpGroupDecorate Decoration group <id> '"
                << inst->words[decorationGroupIndex] << "' is not defined.";
            return false);
-  spvCheck(SpvOpDecorationGroup != decorationGroup->second.opcode,
+  spvCheck(SpvOpDecorationGroup != decorationGroup->opcode,
            DIAG(decorationGroupIndex)
                << "OpGroupDecorate Decoration group <id> '"
                << inst->words[decorationGroupIndex]
@@ -253,17 +341,17 @@ bool idUsage::isValid<SpvOpGroupDecorate>(const spv_instruction_t* inst,
 #if 0
 template <>
 bool idUsage::isValid<SpvOpGroupMemberDecorate>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<SpvOpExtInst>(const spv_instruction_t *inst,
+bool idUsage::isValid<SpvOpExtInst>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 template <>
-bool idUsage::isValid<SpvOpEntryPoint>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpEntryPoint>(const spv_instruction_view_t* inst,
                                        const spv_opcode_desc) {
   auto entryPointIndex = 2;
   auto entryPoint = find(inst->words[entryPointIndex]);
@@ -272,23 +360,23 @@ bool idUsage::isValid<SpvOpEntryPoint>(const spv_instruction_t* inst,
                                    << inst->words[entryPointIndex]
                                    << "' is not defined.";
            return false);
-  spvCheck(SpvOpFunction != entryPoint->second.opcode,
+  spvCheck(SpvOpFunction != entryPoint->opcode,
            DIAG(entryPointIndex) << "OpEntryPoint Entry Point <id> '"
                                  << inst->words[entryPointIndex]
                                  << "' is not a function.";
            return false);
   // TODO: Check the entry point signature is void main(void), may be subject
   // to change
-  auto entryPointType = find(entryPoint->second.inst->words[4]);
+  auto entryPointType = find(entryPoint->inst->words[4]);
   spvCheck(!found(entryPointType), assert(0 && "Unreachable!"));
-  spvCheck(3 != entryPointType->second.inst->words.size(),
+  spvCheck(3 != entryPointType->inst->words.size(),
            DIAG(entryPointIndex) << "OpEntryPoint Entry Point <id> '"
                                  << inst->words[entryPointIndex]
                                  << "'s function parameter count is not zero.";
            return false);
-  auto returnType = find(entryPoint->second.inst->words[1]);
+  auto returnType = find(entryPoint->inst->words[1]);
   spvCheck(!found(returnType), assert(0 && "Unreachable!"));
-  spvCheck(SpvOpTypeVoid != returnType->second.opcode,
+  spvCheck(SpvOpTypeVoid != returnType->opcode,
            DIAG(entryPointIndex) << "OpEntryPoint Entry Point <id> '"
                                  << inst->words[entryPointIndex]
                                  << "'s function return type is not void.";
@@ -297,7 +385,7 @@ bool idUsage::isValid<SpvOpEntryPoint>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpExecutionMode>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpExecutionMode>(const spv_instruction_view_t* inst,
                                           const spv_opcode_desc) {
   auto entryPointIndex = 1;
   auto entryPoint = find(inst->words[entryPointIndex]);
@@ -309,8 +397,8 @@ bool idUsage::isValid<SpvOpExecutionMode>(const spv_instruction_t* inst,
   auto entryPointUses = findUses(inst->words[entryPointIndex]);
   spvCheck(!foundUses(entryPointUses), assert(0 && "Unreachable!"));
   bool foundEntryPointUse = false;
-  for (auto use : entryPointUses->second) {
-    if (SpvOpEntryPoint == use.opcode) {
+  for (auto use : entryPointUses) {
+    if (SpvOpEntryPoint == use->opcode) {
       foundEntryPointUse = true;
     }
   }
@@ -324,7 +412,7 @@ bool idUsage::isValid<SpvOpExecutionMode>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypeVector>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpTypeVector>(const spv_instruction_view_t* inst,
                                        const spv_opcode_desc) {
   auto componentIndex = 2;
   auto componentType = find(inst->words[componentIndex]);
@@ -333,7 +421,7 @@ bool idUsage::isValid<SpvOpTypeVector>(const spv_instruction_t* inst,
                                       << inst->words[componentIndex]
                                       << "' is not defined.";
            return false);
-  spvCheck(!spvOpcodeIsScalarType(componentType->second.opcode),
+  spvCheck(!spvOpcodeIsScalarType(componentType->opcode),
            DIAG(componentIndex) << "OpTypeVector Component Type <id> '"
                                 << inst->words[componentIndex]
                                 << "' is not a scalar type.";
@@ -342,7 +430,7 @@ bool idUsage::isValid<SpvOpTypeVector>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypeMatrix>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpTypeMatrix>(const spv_instruction_view_t* inst,
                                        const spv_opcode_desc) {
   auto columnTypeIndex = 2;
   auto columnType = find(inst->words[columnTypeIndex]);
@@ -351,7 +439,7 @@ bool idUsage::isValid<SpvOpTypeMatrix>(const spv_instruction_t* inst,
                                    << inst->words[columnTypeIndex]
                                    << "' is not defined.";
            return false);
-  spvCheck(SpvOpTypeVector != columnType->second.opcode,
+  spvCheck(SpvOpTypeVector != columnType->opcode,
            DIAG(columnTypeIndex) << "OpTypeMatrix Column Type <id> '"
                                  << inst->words[columnTypeIndex]
                                  << "' is not a vector.";
@@ -360,14 +448,14 @@ bool idUsage::isValid<SpvOpTypeMatrix>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypeSampler>(const spv_instruction_t*,
+bool idUsage::isValid<SpvOpTypeSampler>(const spv_instruction_view_t*,
                                         const spv_opcode_desc) {
   // OpTypeSampler takes no arguments in Rev31 and beyond.
   return true;
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypeArray>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpTypeArray>(const spv_instruction_view_t* inst,
                                       const spv_opcode_desc) {
   auto elementTypeIndex = 2;
   auto elementType = find(inst->words[elementTypeIndex]);
@@ -376,7 +464,7 @@ bool idUsage::isValid<SpvOpTypeArray>(const spv_instruction_t* inst,
                                     << inst->words[elementTypeIndex]
                                     << "' is not defined.";
            return false);
-  spvCheck(!spvOpcodeGeneratesType(elementType->second.opcode),
+  spvCheck(!spvOpcodeGeneratesType(elementType->opcode),
            DIAG(elementTypeIndex) << "OpTypeArray Element Type <id> '"
                                   << inst->words[elementTypeIndex]
                                   << "' is not a type.";
@@ -387,15 +475,15 @@ bool idUsage::isValid<SpvOpTypeArray>(const spv_instruction_t* inst,
                                              << inst->words[lengthIndex]
                                              << "' is not defined.";
            return false);
-  spvCheck(SpvOpConstant != length->second.opcode &&
-               SpvOpSpecConstant != length->second.opcode,
+  spvCheck(SpvOpConstant != length->opcode &&
+               SpvOpSpecConstant != length->opcode,
            DIAG(lengthIndex) << "OpTypeArray Length <id> '"
                              << inst->words[lengthIndex]
                              << "' is not a scalar constant type.";
            return false);
 
   // NOTE: Check the initialiser value of the constant
-  auto constInst = length->second.inst;
+  auto constInst = length->inst;
   auto constResultTypeIndex = 1;
   auto constResultType = find(constInst->words[constResultTypeIndex]);
   spvCheck(!found(constResultType), DIAG(lengthIndex)
@@ -403,7 +491,7 @@ bool idUsage::isValid<SpvOpTypeArray>(const spv_instruction_t* inst,
                                         << inst->words[constResultTypeIndex]
                                         << "' result type is not defined.";
            return false);
-  spvCheck(SpvOpTypeInt != constResultType->second.opcode,
+  spvCheck(SpvOpTypeInt != constResultType->opcode,
            DIAG(lengthIndex) << "OpTypeArray Length <id> '"
                              << inst->words[lengthIndex]
                              << "' is not a constant integer type.";
@@ -417,7 +505,7 @@ bool idUsage::isValid<SpvOpTypeArray>(const spv_instruction_t* inst,
   } else if (5 == constInst->words.size()) {
     uint64_t value =
         constInst->words[3] | ((uint64_t)constInst->words[4]) << 32;
-    bool signedness = constResultType->second.inst->words[3] != 0;
+    bool signedness = constResultType->inst->words[3] != 0;
     if (signedness) {
       spvCheck(1 > (int64_t)value, DIAG(lengthIndex)
                                        << "OpTypeArray Length <id> '"
@@ -435,7 +523,7 @@ bool idUsage::isValid<SpvOpTypeArray>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypeRuntimeArray>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpTypeRuntimeArray>(const spv_instruction_view_t* inst,
                                              const spv_opcode_desc) {
   auto elementTypeIndex = 2;
   auto elementType = find(inst->words[elementTypeIndex]);
@@ -444,7 +532,7 @@ bool idUsage::isValid<SpvOpTypeRuntimeArray>(const spv_instruction_t* inst,
                                     << inst->words[elementTypeIndex]
                                     << "' is not defined.";
            return false);
-  spvCheck(!spvOpcodeGeneratesType(elementType->second.opcode),
+  spvCheck(!spvOpcodeGeneratesType(elementType->opcode),
            DIAG(elementTypeIndex) << "OpTypeRuntimeArray Element Type <id> '"
                                   << inst->words[elementTypeIndex]
                                   << "' is not a type.";
@@ -453,7 +541,7 @@ bool idUsage::isValid<SpvOpTypeRuntimeArray>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypeStruct>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpTypeStruct>(const spv_instruction_view_t* inst,
                                        const spv_opcode_desc) {
   for (size_t memberTypeIndex = 2; memberTypeIndex < inst->words.size();
        ++memberTypeIndex) {
@@ -463,7 +551,7 @@ bool idUsage::isValid<SpvOpTypeStruct>(const spv_instruction_t* inst,
                                      << inst->words[memberTypeIndex]
                                      << "' is not defined.";
              return false);
-    spvCheck(!spvOpcodeGeneratesType(memberType->second.opcode),
+    spvCheck(!spvOpcodeGeneratesType(memberType->opcode),
              DIAG(memberTypeIndex) << "OpTypeStruct Member Type <id> '"
                                    << inst->words[memberTypeIndex]
                                    << "' is not a type.";
@@ -473,7 +561,7 @@ bool idUsage::isValid<SpvOpTypeStruct>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypePointer>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpTypePointer>(const spv_instruction_view_t* inst,
                                         const spv_opcode_desc) {
   auto typeIndex = 3;
   auto type = find(inst->words[typeIndex]);
@@ -481,7 +569,7 @@ bool idUsage::isValid<SpvOpTypePointer>(const spv_instruction_t* inst,
                                          << inst->words[typeIndex]
                                          << "' is not defined.";
            return false);
-  spvCheck(!spvOpcodeGeneratesType(type->second.opcode),
+  spvCheck(!spvOpcodeGeneratesType(type->opcode),
            DIAG(typeIndex) << "OpTypePointer Type <id> '"
                            << inst->words[typeIndex] << "' is not a type.";
            return false);
@@ -489,7 +577,7 @@ bool idUsage::isValid<SpvOpTypePointer>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypeFunction>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpTypeFunction>(const spv_instruction_view_t* inst,
                                          const spv_opcode_desc) {
   auto returnTypeIndex = 2;
   auto returnType = find(inst->words[returnTypeIndex]);
@@ -498,7 +586,7 @@ bool idUsage::isValid<SpvOpTypeFunction>(const spv_instruction_t* inst,
                                    << inst->words[returnTypeIndex]
                                    << "' is not defined";
            return false);
-  spvCheck(!spvOpcodeGeneratesType(returnType->second.opcode),
+  spvCheck(!spvOpcodeGeneratesType(returnType->opcode),
            DIAG(returnTypeIndex) << "OpTypeFunction Return Type <id> '"
                                  << inst->words[returnTypeIndex]
                                  << "' is not a type.";
@@ -511,7 +599,7 @@ bool idUsage::isValid<SpvOpTypeFunction>(const spv_instruction_t* inst,
                                     << inst->words[paramTypeIndex]
                                     << "' is not defined.";
              return false);
-    spvCheck(!spvOpcodeGeneratesType(paramType->second.opcode),
+    spvCheck(!spvOpcodeGeneratesType(paramType->opcode),
              DIAG(paramTypeIndex) << "OpTypeFunction Parameter Type <id> '"
                                   << inst->words[paramTypeIndex]
                                   << "' is not a type.";
@@ -521,14 +609,14 @@ bool idUsage::isValid<SpvOpTypeFunction>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypePipe>(const spv_instruction_t*,
+bool idUsage::isValid<SpvOpTypePipe>(const spv_instruction_view_t*,
                                      const spv_opcode_desc) {
   // OpTypePipe has no ID arguments.
   return true;
 }
 
 template <>
-bool idUsage::isValid<SpvOpConstantTrue>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpConstantTrue>(const spv_instruction_view_t* inst,
                                          const spv_opcode_desc) {
   auto resultTypeIndex = 1;
   auto resultType = find(inst->words[resultTypeIndex]);
@@ -537,7 +625,7 @@ bool idUsage::isValid<SpvOpConstantTrue>(const spv_instruction_t* inst,
                                    << inst->words[resultTypeIndex]
                                    << "' is not defined.";
            return false);
-  spvCheck(SpvOpTypeBool != resultType->second.opcode,
+  spvCheck(SpvOpTypeBool != resultType->opcode,
            DIAG(resultTypeIndex) << "OpConstantTrue Result Type <id> '"
                                  << inst->words[resultTypeIndex]
                                  << "' is not a boolean type.";
@@ -546,7 +634,7 @@ bool idUsage::isValid<SpvOpConstantTrue>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpConstantFalse>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpConstantFalse>(const spv_instruction_view_t* inst,
                                           const spv_opcode_desc) {
   auto resultTypeIndex = 1;
   auto resultType = find(inst->words[resultTypeIndex]);
@@ -555,7 +643,7 @@ bool idUsage::isValid<SpvOpConstantFalse>(const spv_instruction_t* inst,
                                    << inst->words[resultTypeIndex]
                                    << "' is not defined.";
            return false);
-  spvCheck(SpvOpTypeBool != resultType->second.opcode,
+  spvCheck(SpvOpTypeBool != resultType->opcode,
            DIAG(resultTypeIndex) << "OpConstantFalse Result Type <id> '"
                                  << inst->words[resultTypeIndex]
                                  << "' is not a boolean type.";
@@ -564,7 +652,7 @@ bool idUsage::isValid<SpvOpConstantFalse>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpConstant>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpConstant>(const spv_instruction_view_t* inst,
                                      const spv_opcode_desc) {
   auto resultTypeIndex = 1;
   auto resultType = find(inst->words[resultTypeIndex]);
@@ -573,7 +661,7 @@ bool idUsage::isValid<SpvOpConstant>(const spv_instruction_t* inst,
                                    << inst->words[resultTypeIndex]
                                    << "' is not defined.";
            return false);
-  spvCheck(!spvOpcodeIsScalarType(resultType->second.opcode),
+  spvCheck(!spvOpcodeIsScalarType(resultType->opcode),
            DIAG(resultTypeIndex)
                << "OpConstant Result Type <id> '"
                << inst->words[resultTypeIndex]
@@ -583,8 +671,8 @@ bool idUsage::isValid<SpvOpConstant>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
-                                              const spv_opcode_desc) {
+bool idUsage::isValid<SpvOpConstantComposite>(
+    const spv_instruction_view_t* inst, const spv_opcode_desc) {
   auto resultTypeIndex = 1;
   auto resultType = find(inst->words[resultTypeIndex]);
   spvCheck(!found(resultType), DIAG(resultTypeIndex)
@@ -592,62 +680,62 @@ bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
                                    << inst->words[resultTypeIndex]
                                    << "' is not defined.";
            return false);
-  spvCheck(!spvOpcodeIsComposite(resultType->second.opcode),
+  spvCheck(!spvOpcodeIsComposite(resultType->opcode),
            DIAG(resultTypeIndex) << "OpConstantComposite Result Type <id> '"
                                  << inst->words[resultTypeIndex]
                                  << "' is not a composite type.";
            return false);
 
   auto constituentCount = inst->words.size() - 3;
-  switch (resultType->second.opcode) {
+  switch (resultType->opcode) {
     case SpvOpTypeVector: {
-      auto componentCount = resultType->second.inst->words[3];
+      auto componentCount = resultType->inst->words[3];
       spvCheck(
           componentCount != constituentCount,
           // TODO: Output ID's on diagnostic
           DIAG(inst->words.size() - 1)
               << "OpConstantComposite Constituent <id> count does not match "
                  "Result Type <id> '"
-              << resultType->second.id << "'s vector component count.";
+              << resultType->id << "'s vector component count.";
           return false);
-      auto componentType = find(resultType->second.inst->words[2]);
+      auto componentType = find(resultType->inst->words[2]);
       spvCheck(!found(componentType), assert(0 && "Unreachable!"));
       for (size_t constituentIndex = 3; constituentIndex < inst->words.size();
            constituentIndex++) {
         auto constituent = find(inst->words[constituentIndex]);
         spvCheck(!found(constituent), assert(0 && "Unreachable!"));
-        spvCheck(!spvOpcodeIsConstant(constituent->second.opcode),
+        spvCheck(!spvOpcodeIsConstant(constituent->opcode),
                  DIAG(constituentIndex)
                      << "OpConstantComposite Constituent <id> '"
                      << inst->words[constituentIndex] << "' is not a constant.";
                  return false);
-        auto constituentResultType = find(constituent->second.inst->words[1]);
+        auto constituentResultType = find(constituent->inst->words[1]);
         spvCheck(!found(constituentResultType), assert(0 && "Unreachable!"));
-        spvCheck(componentType->second.opcode !=
-                     constituentResultType->second.opcode,
+        spvCheck(componentType->opcode !=
+                     constituentResultType->opcode,
                  DIAG(constituentIndex)
                      << "OpConstantComposite Constituent <id> '"
                      << inst->words[constituentIndex]
                      << "'s type does not match Result Type <id> '"
-                     << resultType->second.id << "'s vector element type.";
+                     << resultType->id << "'s vector element type.";
                  return false);
       }
     } break;
     case SpvOpTypeMatrix: {
-      auto columnCount = resultType->second.inst->words[3];
+      auto columnCount = resultType->inst->words[3];
       spvCheck(
           columnCount != constituentCount,
           // TODO: Output ID's on diagnostic
           DIAG(inst->words.size() - 1)
               << "OpConstantComposite Constituent <id> count does not match "
                  "Result Type <id> '"
-              << resultType->second.id << "'s matrix column count.";
+              << resultType->id << "'s matrix column count.";
           return false);
 
-      auto columnType = find(resultType->second.inst->words[2]);
+      auto columnType = find(resultType->inst->words[2]);
       spvCheck(!found(columnType), assert(0 && "Unreachable!"));
-      auto componentCount = columnType->second.inst->words[3];
-      auto componentType = find(columnType->second.inst->words[2]);
+      auto componentCount = columnType->inst->words[3];
+      auto componentType = find(columnType->inst->words[2]);
       spvCheck(!found(componentType), assert(0 && "Unreachable!"));
 
       for (size_t constituentIndex = 3; constituentIndex < inst->words.size();
@@ -658,52 +746,52 @@ bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
                      << "OpConstantComposite Constituent <id> '"
                      << inst->words[constituentIndex] << "' is not defined.";
                  return false);
-        spvCheck(SpvOpConstantComposite != constituent->second.opcode,
+        spvCheck(SpvOpConstantComposite != constituent->opcode,
                  DIAG(constituentIndex)
                      << "OpConstantComposite Constituent <id> '"
                      << inst->words[constituentIndex]
                      << "' is not a constant composite.";
                  return false);
-        auto vector = find(constituent->second.inst->words[1]);
+        auto vector = find(constituent->inst->words[1]);
         spvCheck(!found(vector), assert(0 && "Unreachable!"));
-        spvCheck(columnType->second.opcode != vector->second.opcode,
+        spvCheck(columnType->opcode != vector->opcode,
                  DIAG(constituentIndex)
                      << "OpConstantComposite Constituent <id> '"
                      << inst->words[constituentIndex]
                      << "' type does not match Result Type <id> '"
-                     << resultType->second.id << "'s matrix column type.";
+                     << resultType->id << "'s matrix column type.";
                  return false);
-        auto vectorComponentType = find(vector->second.inst->words[2]);
+        auto vectorComponentType = find(vector->inst->words[2]);
         spvCheck(!found(vectorComponentType), assert(0 && "Unreachable!"));
-        spvCheck(!spvOpcodeAreTypesEqual(componentType->second.inst,
-                                         vectorComponentType->second.inst),
+        spvCheck(!spvOpcodeAreTypesEqual(componentType->inst,
+                                         vectorComponentType->inst),
                  DIAG(constituentIndex)
                      << "OpConstantComposite Constituent <id> '"
                      << inst->words[constituentIndex]
                      << "' component type does not match Result Type <id> '"
-                     << resultType->second.id
+                     << resultType->id
                      << "'s matrix column component type.";
                  return false);
         spvCheck(
-            componentCount != vector->second.inst->words[3],
+            componentCount != vector->inst->words[3],
             DIAG(constituentIndex)
                 << "OpConstantComposite Constituent <id> '"
                 << inst->words[constituentIndex]
                 << "' vector component count does not match Result Type <id> '"
-                << resultType->second.id << "'s vector component count.";
+                << resultType->id << "'s vector component count.";
             return false);
       }
     } break;
     case SpvOpTypeArray: {
-      auto elementType = find(resultType->second.inst->words[2]);
+      auto elementType = find(resultType->inst->words[2]);
       spvCheck(!found(elementType), assert(0 && "Unreachable!"));
-      auto length = find(resultType->second.inst->words[3]);
+      auto length = find(resultType->inst->words[3]);
       spvCheck(!found(length), assert(0 && "Unreachable!"));
-      spvCheck(length->second.inst->words[3] != constituentCount,
+      spvCheck(length->inst->words[3] != constituentCount,
                DIAG(inst->words.size() - 1)
                    << "OpConstantComposite Constituent count does not match "
                       "Result Type <id> '"
-                   << resultType->second.id << "'s array length.";
+                   << resultType->id << "'s array length.";
                return false);
       for (size_t constituentIndex = 3; constituentIndex < inst->words.size();
            constituentIndex++) {
@@ -713,31 +801,31 @@ bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
                      << "OpConstantComposite Constituent <id> '"
                      << inst->words[constituentIndex] << "' is not defined.";
                  return false);
-        spvCheck(!spvOpcodeIsConstant(constituent->second.opcode),
+        spvCheck(!spvOpcodeIsConstant(constituent->opcode),
                  DIAG(constituentIndex)
                      << "OpConstantComposite Constituent <id> '"
                      << inst->words[constituentIndex] << "' is not a constant.";
                  return false);
-        auto constituentType = find(constituent->second.inst->words[1]);
+        auto constituentType = find(constituent->inst->words[1]);
         spvCheck(!found(constituentType), assert(0 && "Unreachable!"));
-        spvCheck(!spvOpcodeAreTypesEqual(elementType->second.inst,
-                                         constituentType->second.inst),
+        spvCheck(!spvOpcodeAreTypesEqual(elementType->inst,
+                                         constituentType->inst),
                  DIAG(constituentIndex)
                      << "OpConstantComposite Constituent <id> '"
                      << inst->words[constituentIndex]
                      << "'s type does not match Result Type <id> '"
-                     << resultType->second.id << "'s array element type.";
+                     << resultType->id << "'s array element type.";
                  return false);
       }
     } break;
     case SpvOpTypeStruct: {
-      auto memberCount = resultType->second.inst->words.size() - 2;
+      auto memberCount = resultType->inst->words.size() - 2;
       spvCheck(memberCount != constituentCount,
                DIAG(resultTypeIndex)
                    << "OpConstantComposite Constituent <id> '"
                    << inst->words[resultTypeIndex]
                    << "' count does not match Result Type <id> '"
-                   << resultType->second.id << "'s struct member count.";
+                   << resultType->id << "'s struct member count.";
                return false);
       for (uint32_t constituentIndex = 3, memberIndex = 2;
            constituentIndex < inst->words.size();
@@ -748,23 +836,23 @@ bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
                      << "OpConstantComposite Constituent <id> '"
                      << inst->words[constituentIndex] << "' is not define.";
                  return false);
-        spvCheck(!spvOpcodeIsConstant(constituent->second.opcode),
+        spvCheck(!spvOpcodeIsConstant(constituent->opcode),
                  DIAG(constituentIndex)
                      << "OpConstantComposite Constituent <id> '"
                      << inst->words[constituentIndex] << "' is not a constant.";
                  return false);
-        auto constituentType = find(constituent->second.inst->words[1]);
+        auto constituentType = find(constituent->inst->words[1]);
         spvCheck(!found(constituentType), assert(0 && "Unreachable!"));
 
-        auto memberType = find(resultType->second.inst->words[memberIndex]);
+        auto memberType = find(resultType->inst->words[memberIndex]);
         spvCheck(!found(memberType), assert(0 && "Unreachable!"));
-        spvCheck(!spvOpcodeAreTypesEqual(memberType->second.inst,
-                                         constituentType->second.inst),
+        spvCheck(!spvOpcodeAreTypesEqual(memberType->inst,
+                                         constituentType->inst),
                  DIAG(constituentIndex)
                      << "OpConstantComposite Constituent <id> '"
                      << inst->words[constituentIndex]
                      << "' type does not match the Result Type <id> '"
-                     << resultType->second.id << "'s member type.";
+                     << resultType->id << "'s member type.";
                  return false);
       }
     } break;
@@ -774,7 +862,7 @@ bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpConstantSampler>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpConstantSampler>(const spv_instruction_view_t* inst,
                                             const spv_opcode_desc) {
   auto resultTypeIndex = 1;
   auto resultType = find(inst->words[resultTypeIndex]);
@@ -783,7 +871,7 @@ bool idUsage::isValid<SpvOpConstantSampler>(const spv_instruction_t* inst,
                                    << inst->words[resultTypeIndex]
                                    << "' is not defined.";
            return false);
-  spvCheck(SpvOpTypeSampler != resultType->second.opcode,
+  spvCheck(SpvOpTypeSampler != resultType->opcode,
            DIAG(resultTypeIndex) << "OpConstantSampler Result Type <id> '"
                                  << inst->words[resultTypeIndex]
                                  << "' is not a sampler type.";
@@ -792,7 +880,7 @@ bool idUsage::isValid<SpvOpConstantSampler>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpConstantNull>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpConstantNull>(const spv_instruction_view_t* inst,
                                          const spv_opcode_desc) {
   auto resultTypeIndex = 1;
   auto resultType = find(inst->words[resultTypeIndex]);
@@ -801,18 +889,18 @@ bool idUsage::isValid<SpvOpConstantNull>(const spv_instruction_t* inst,
                                    << inst->words[resultTypeIndex]
                                    << "' is not defined.";
            return false);
-  switch (resultType->second.inst->opcode) {
+  switch (resultType->inst->opcode) {
     default: {
-      spvCheck(!spvOpcodeIsBasicTypeNullable(resultType->second.inst->opcode),
+      spvCheck(!spvOpcodeIsBasicTypeNullable(resultType->inst->opcode),
                DIAG(resultTypeIndex) << "OpConstantNull Result Type <id> '"
                                      << inst->words[resultTypeIndex]
                                      << "' can not be null.";
                return false);
     } break;
     case SpvOpTypeVector: {
-      auto type = find(resultType->second.inst->words[2]);
+      auto type = find(resultType->inst->words[2]);
       spvCheck(!found(type), assert(0 && "Unreachable!"));
-      spvCheck(!spvOpcodeIsBasicTypeNullable(type->second.inst->opcode),
+      spvCheck(!spvOpcodeIsBasicTypeNullable(type->inst->opcode),
                DIAG(resultTypeIndex)
                    << "OpConstantNull Result Type <id> '"
                    << inst->words[resultTypeIndex]
@@ -820,9 +908,9 @@ bool idUsage::isValid<SpvOpConstantNull>(const spv_instruction_t* inst,
                return false);
     } break;
     case SpvOpTypeArray: {
-      auto type = find(resultType->second.inst->words[2]);
+      auto type = find(resultType->inst->words[2]);
       spvCheck(!found(type), assert(0 && "Unreachable!"));
-      spvCheck(!spvOpcodeIsBasicTypeNullable(type->second.inst->opcode),
+      spvCheck(!spvOpcodeIsBasicTypeNullable(type->inst->opcode),
                DIAG(resultTypeIndex)
                    << "OpConstantNull Result Type <id> '"
                    << inst->words[resultTypeIndex]
@@ -830,11 +918,11 @@ bool idUsage::isValid<SpvOpConstantNull>(const spv_instruction_t* inst,
                return false);
     } break;
     case SpvOpTypeMatrix: {
-      auto columnType = find(resultType->second.inst->words[2]);
+      auto columnType = find(resultType->inst->words[2]);
       spvCheck(!found(columnType), assert(0 && "Unreachable!"));
-      auto type = find(columnType->second.inst->words[2]);
+      auto type = find(columnType->inst->words[2]);
       spvCheck(!found(type), assert(0 && "Unreachable!"));
-      spvCheck(!spvOpcodeIsBasicTypeNullable(type->second.inst->opcode),
+      spvCheck(!spvOpcodeIsBasicTypeNullable(type->inst->opcode),
                DIAG(resultTypeIndex)
                    << "OpConstantNull Result Type <id> '"
                    << inst->words[resultTypeIndex]
@@ -843,11 +931,11 @@ bool idUsage::isValid<SpvOpConstantNull>(const spv_instruction_t* inst,
     } break;
     case SpvOpTypeStruct: {
       for (size_t elementIndex = 2;
-           elementIndex < resultType->second.inst->words.size();
+           elementIndex < resultType->inst->words.size();
            ++elementIndex) {
-        auto element = find(resultType->second.inst->words[elementIndex]);
+        auto element = find(resultType->inst->words[elementIndex]);
         spvCheck(!found(element), assert(0 && "Unreachable!"));
-        spvCheck(!spvOpcodeIsBasicTypeNullable(element->second.inst->opcode),
+        spvCheck(!spvOpcodeIsBasicTypeNullable(element->inst->opcode),
                  DIAG(resultTypeIndex)
                      << "OpConstantNull Result Type <id> '"
                      << inst->words[resultTypeIndex]
@@ -860,7 +948,7 @@ bool idUsage::isValid<SpvOpConstantNull>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpSpecConstantTrue>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpSpecConstantTrue>(const spv_instruction_view_t* inst,
                                              const spv_opcode_desc) {
   auto resultTypeIndex = 1;
   auto resultType = find(inst->words[resultTypeIndex]);
@@ -869,7 +957,7 @@ bool idUsage::isValid<SpvOpSpecConstantTrue>(const spv_instruction_t* inst,
                                    << inst->words[resultTypeIndex]
                                    << "' is not defined.";
            return false);
-  spvCheck(SpvOpTypeBool != resultType->second.opcode,
+  spvCheck(SpvOpTypeBool != resultType->opcode,
            DIAG(resultTypeIndex) << "OpSpecConstantTrue Result Type <id> '"
                                  << inst->words[resultTypeIndex]
                                  << "' is not a boolean type.";
@@ -878,8 +966,8 @@ bool idUsage::isValid<SpvOpSpecConstantTrue>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpSpecConstantFalse>(const spv_instruction_t* inst,
-                                              const spv_opcode_desc) {
+bool idUsage::isValid<SpvOpSpecConstantFalse>(
+    const spv_instruction_view_t* inst, const spv_opcode_desc) {
   auto resultTypeIndex = 1;
   auto resultType = find(inst->words[resultTypeIndex]);
   spvCheck(!found(resultType), DIAG(resultTypeIndex)
@@ -887,7 +975,7 @@ bool idUsage::isValid<SpvOpSpecConstantFalse>(const spv_instruction_t* inst,
                                    << inst->words[resultTypeIndex]
                                    << "' is not defined.";
            return false);
-  spvCheck(SpvOpTypeBool != resultType->second.opcode,
+  spvCheck(SpvOpTypeBool != resultType->opcode,
            DIAG(resultTypeIndex) << "OpSpecConstantFalse Result Type <id> '"
                                  << inst->words[resultTypeIndex]
                                  << "' is not a boolean type.";
@@ -896,7 +984,7 @@ bool idUsage::isValid<SpvOpSpecConstantFalse>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpSpecConstant>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpSpecConstant>(const spv_instruction_view_t* inst,
                                          const spv_opcode_desc) {
   auto resultTypeIndex = 1;
   auto resultType = find(inst->words[resultTypeIndex]);
@@ -905,7 +993,7 @@ bool idUsage::isValid<SpvOpSpecConstant>(const spv_instruction_t* inst,
                                    << inst->words[resultTypeIndex]
                                    << "' is not defined.";
            return false);
-  spvCheck(!spvOpcodeIsScalarType(resultType->second.opcode),
+  spvCheck(!spvOpcodeIsScalarType(resultType->opcode),
            DIAG(resultTypeIndex) << "OpSpecConstant Result Type <id> '"
                                  << inst->words[resultTypeIndex]
                                  << "' is not a scalar type.";
@@ -916,16 +1004,17 @@ bool idUsage::isValid<SpvOpSpecConstant>(const spv_instruction_t* inst,
 #if 0
 template <>
 bool idUsage::isValid<SpvOpSpecConstantComposite>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<SpvOpSpecConstantOp>(const spv_instruction_t *inst) {}
+bool idUsage::isValid<SpvOpSpecConstantOp>(
+    const spv_instruction_view_t *inst) {}
 #endif
 
 template <>
-bool idUsage::isValid<SpvOpVariable>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpVariable>(const spv_instruction_view_t* inst,
                                      const spv_opcode_desc opcodeEntry) {
   auto resultTypeIndex = 1;
   auto resultType = find(inst->words[resultTypeIndex]);
@@ -934,7 +1023,7 @@ bool idUsage::isValid<SpvOpVariable>(const spv_instruction_t* inst,
                                    << inst->words[resultTypeIndex]
                                    << "' is not defined.";
            return false);
-  spvCheck(SpvOpTypePointer != resultType->second.opcode,
+  spvCheck(SpvOpTypePointer != resultType->opcode,
            DIAG(resultTypeIndex) << "OpVariable Result Type <id> '"
                                  << inst->words[resultTypeIndex]
                                  << "' is not a pointer type.";
@@ -947,7 +1036,7 @@ bool idUsage::isValid<SpvOpVariable>(const spv_instruction_t* inst,
                                       << inst->words[initialiserIndex]
                                       << "' is not defined.";
              return false);
-    spvCheck(!spvOpcodeIsConstant(initialiser->second.opcode),
+    spvCheck(!spvOpcodeIsConstant(initialiser->opcode),
              DIAG(initialiserIndex) << "OpVariable Initializer <id> '"
                                     << inst->words[initialiserIndex]
                                     << "' is not a constant.";
@@ -957,7 +1046,7 @@ bool idUsage::isValid<SpvOpVariable>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpLoad>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpLoad>(const spv_instruction_view_t* inst,
                                  const spv_opcode_desc) {
   auto resultTypeIndex = 1;
   auto resultType = find(inst->words[resultTypeIndex]);
@@ -972,24 +1061,24 @@ bool idUsage::isValid<SpvOpLoad>(const spv_instruction_t* inst,
                                                << inst->words[pointerIndex]
                                                << "' is not defined.";
            return false);
-  spvCheck(!spvOpcodeIsPointer(pointer->second.opcode),
+  spvCheck(!spvOpcodeIsPointer(pointer->opcode),
            DIAG(pointerIndex) << "OpLoad Pointer <id> '"
                               << inst->words[pointerIndex]
                               << "' is not a pointer.";
            return false);
-  auto type = find(pointer->second.inst->words[1]);
+  auto type = find(pointer->inst->words[1]);
   spvCheck(!found(type), assert(0 && "Unreachable!"));
   spvCheck(resultType != type, DIAG(resultTypeIndex)
                                    << "OpLoad Result Type <id> '"
                                    << inst->words[resultTypeIndex]
                                    << " does not match Pointer <id> '"
-                                   << pointer->second.id << "'s type.";
+                                   << pointer->id << "'s type.";
            return false);
   return true;
 }
 
 template <>
-bool idUsage::isValid<SpvOpStore>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpStore>(const spv_instruction_view_t* inst,
                                   const spv_opcode_desc) {
   auto pointerIndex = 1;
   auto pointer = find(inst->words[pointerIndex]);
@@ -997,16 +1086,16 @@ bool idUsage::isValid<SpvOpStore>(const spv_instruction_t* inst,
                                                << inst->words[pointerIndex]
                                                << "' is not defined.";
            return false);
-  spvCheck(!spvOpcodeIsPointer(pointer->second.opcode),
+  spvCheck(!spvOpcodeIsPointer(pointer->opcode),
            DIAG(pointerIndex) << "OpStore Pointer <id> '"
                               << inst->words[pointerIndex]
                               << "' is not a pointer.";
            return false);
-  auto pointerType = find(pointer->second.inst->words[1]);
+  auto pointerType = find(pointer->inst->words[1]);
   spvCheck(!found(pointerType), assert(0 && "Unreachable!"));
-  auto type = find(pointerType->second.inst->words[3]);
+  auto type = find(pointerType->inst->words[3]);
   spvCheck(!found(type), assert(0 && "Unreachable!"));
-  spvCheck(SpvOpTypeVoid == type->second.opcode,
+  spvCheck(SpvOpTypeVoid == type->opcode,
            DIAG(pointerIndex) << "OpStore Pointer <id> '"
                               << inst->words[pointerIndex]
                               << "'s type is void.";
@@ -1018,29 +1107,29 @@ bool idUsage::isValid<SpvOpStore>(const spv_instruction_t* inst,
                                              << inst->words[objectIndex]
                                              << "' is not defined.";
            return false);
-  spvCheck(!spvOpcodeIsObject(object->second.opcode),
+  spvCheck(!spvOpcodeIsObject(object->opcode),
            DIAG(objectIndex) << "OpStore Object <id> '"
                              << inst->words[objectIndex]
                              << "' in not an object.";
            return false);
-  auto objectType = find(object->second.inst->words[1]);
+  auto objectType = find(object->inst->words[1]);
   spvCheck(!found(objectType), assert(0 && "Unreachable!"));
-  spvCheck(SpvOpTypeVoid == objectType->second.opcode,
+  spvCheck(SpvOpTypeVoid == objectType->opcode,
            DIAG(objectIndex) << "OpStore Object <id> '"
                              << inst->words[objectIndex] << "'s type is void.";
            return false);
 
-  spvCheck(!spvOpcodeAreTypesEqual(type->second.inst, objectType->second.inst),
+  spvCheck(!spvOpcodeAreTypesEqual(type->inst, objectType->inst),
            DIAG(pointerIndex) << "OpStore Pointer <id> '"
                               << inst->words[pointerIndex]
                               << "'s type does not match Object <id> '"
-                              << objectType->second.id << "'s type.";
+                              << objectType->id << "'s type.";
            return false);
   return true;
 }
 
 template <>
-bool idUsage::isValid<SpvOpCopyMemory>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpCopyMemory>(const spv_instruction_view_t* inst,
                                        const spv_opcode_desc) {
   auto targetIndex = 1;
   auto target = find(inst->words[targetIndex]);
@@ -1054,26 +1143,26 @@ bool idUsage::isValid<SpvOpCopyMemory>(const spv_instruction_t* inst,
                                              << inst->words[targetIndex]
                                              << "' is not defined.";
            return false);
-  auto targetPointerType = find(target->second.inst->words[1]);
+  auto targetPointerType = find(target->inst->words[1]);
   spvCheck(!found(targetPointerType), assert(0 && "Unreachable!"));
-  auto targetType = find(targetPointerType->second.inst->words[3]);
+  auto targetType = find(targetPointerType->inst->words[3]);
   spvCheck(!found(targetType), assert(0 && "Unreachable!"));
-  auto sourcePointerType = find(source->second.inst->words[1]);
+  auto sourcePointerType = find(source->inst->words[1]);
   spvCheck(!found(sourcePointerType), assert(0 && "Unreachable!"));
-  auto sourceType = find(sourcePointerType->second.inst->words[3]);
+  auto sourceType = find(sourcePointerType->inst->words[3]);
   spvCheck(!found(sourceType), assert(0 && "Unreachable!"));
   spvCheck(
-      !spvOpcodeAreTypesEqual(targetType->second.inst, sourceType->second.inst),
+      !spvOpcodeAreTypesEqual(targetType->inst, sourceType->inst),
       DIAG(sourceIndex) << "OpCopyMemory Target <id> '"
                         << inst->words[sourceIndex]
                         << "'s type does not match Source <id> '"
-                        << sourceType->second.id << "'s type.";
+                        << sourceType->id << "'s type.";
       return false);
   return true;
 }
 
 template <>
-bool idUsage::isValid<SpvOpCopyMemorySized>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpCopyMemorySized>(const spv_instruction_view_t* inst,
                                             const spv_opcode_desc) {
   auto targetIndex = 1;
   auto target = find(inst->words[targetIndex]);
@@ -1093,40 +1182,40 @@ bool idUsage::isValid<SpvOpCopyMemorySized>(const spv_instruction_t* inst,
                                          << inst->words[sizeIndex]
                                          << "' is not defined.";
            return false);
-  auto targetPointerType = find(target->second.inst->words[1]);
+  auto targetPointerType = find(target->inst->words[1]);
   spvCheck(!found(targetPointerType), assert(0 && "Unreachable!"));
-  spvCheck(SpvOpTypePointer != targetPointerType->second.opcode,
+  spvCheck(SpvOpTypePointer != targetPointerType->opcode,
            DIAG(targetIndex) << "OpCopyMemorySized Target <id> '"
                              << inst->words[targetIndex]
                              << "' is not a pointer.";
            return false);
-  auto sourcePointerType = find(source->second.inst->words[1]);
+  auto sourcePointerType = find(source->inst->words[1]);
   spvCheck(!found(sourcePointerType), assert(0 && "Unreachable!"));
-  spvCheck(SpvOpTypePointer != sourcePointerType->second.opcode,
+  spvCheck(SpvOpTypePointer != sourcePointerType->opcode,
            DIAG(sourceIndex) << "OpCopyMemorySized Source <id> '"
                              << inst->words[sourceIndex]
                              << "' is not a pointer.";
            return false);
-  switch (size->second.opcode) {
+  switch (size->opcode) {
     // TODO: The following opcode's are assumed to be valid, refer to the
     // following bug https://cvs.khronos.org/bugzilla/show_bug.cgi?id=13871 for
     // clarification
     case SpvOpConstant:
     case SpvOpSpecConstant: {
-      auto sizeType = find(size->second.inst->words[1]);
+      auto sizeType = find(size->inst->words[1]);
       spvCheck(!found(sizeType), assert(0 && "Unreachable!"));
-      spvCheck(SpvOpTypeInt != sizeType->second.opcode,
+      spvCheck(SpvOpTypeInt != sizeType->opcode,
                DIAG(sizeIndex) << "OpCopyMemorySized Size <id> '"
                                << inst->words[sizeIndex]
                                << "'s type is not an integer type.";
                return false);
     } break;
     case SpvOpVariable: {
-      auto pointerType = find(size->second.inst->words[1]);
+      auto pointerType = find(size->inst->words[1]);
       spvCheck(!found(pointerType), assert(0 && "Unreachable!"));
-      auto sizeType = find(pointerType->second.inst->words[1]);
+      auto sizeType = find(pointerType->inst->words[1]);
       spvCheck(!found(sizeType), assert(0 && "Unreachable!"));
-      spvCheck(SpvOpTypeInt != sizeType->second.opcode,
+      spvCheck(SpvOpTypeInt != sizeType->opcode,
                DIAG(sizeIndex) << "OpCopyMemorySized Size <id> '"
                                << inst->words[sizeIndex]
                                << "'s variable type is not an integer type.";
@@ -1145,36 +1234,36 @@ bool idUsage::isValid<SpvOpCopyMemorySized>(const spv_instruction_t* inst,
 
 #if 0
 template <>
-bool idUsage::isValid<SpvOpAccessChain>(const spv_instruction_t *inst,
+bool idUsage::isValid<SpvOpAccessChain>(const spv_instruction_view_t *inst,
                                         const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<SpvOpInBoundsAccessChain>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<SpvOpArrayLength>(const spv_instruction_t *inst,
+bool idUsage::isValid<SpvOpArrayLength>(const spv_instruction_view_t *inst,
                                         const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<SpvOpImagePointer>(const spv_instruction_t *inst,
+bool idUsage::isValid<SpvOpImagePointer>(const spv_instruction_view_t *inst,
                                          const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<SpvOpGenericPtrMemSemantics>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 template <>
-bool idUsage::isValid<SpvOpFunction>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpFunction>(const spv_instruction_view_t* inst,
                                      const spv_opcode_desc) {
   auto resultTypeIndex = 1;
   auto resultType = find(inst->words[resultTypeIndex]);
@@ -1190,25 +1279,25 @@ bool idUsage::isValid<SpvOpFunction>(const spv_instruction_t* inst,
                                      << inst->words[functionTypeIndex]
                                      << "' is not defined.";
            return false);
-  spvCheck(SpvOpTypeFunction != functionType->second.opcode,
+  spvCheck(SpvOpTypeFunction != functionType->opcode,
            DIAG(functionTypeIndex) << "OpFunction Function Type <id> '"
                                    << inst->words[functionTypeIndex]
                                    << "' is not a function type.";
            return false);
-  auto returnType = find(functionType->second.inst->words[2]);
+  auto returnType = find(functionType->inst->words[2]);
   spvCheck(!found(returnType), assert(0 && "Unreachable!"));
   spvCheck(returnType != resultType,
            DIAG(resultTypeIndex) << "OpFunction Result Type <id> '"
                                  << inst->words[resultTypeIndex]
                                  << "' does not match the Function Type <id> '"
-                                 << resultType->second.id << "'s return type.";
+                                 << resultType->id << "'s return type.";
            return false);
   return true;
 }
 
 template <>
-bool idUsage::isValid<SpvOpFunctionParameter>(const spv_instruction_t* inst,
-                                              const spv_opcode_desc) {
+bool idUsage::isValid<SpvOpFunctionParameter>(
+    const spv_instruction_view_t* inst, const spv_opcode_desc) {
   auto resultTypeIndex = 1;
   auto resultType = find(inst->words[resultTypeIndex]);
   spvCheck(!found(resultType), DIAG(resultTypeIndex)
@@ -1232,10 +1321,10 @@ bool idUsage::isValid<SpvOpFunctionParameter>(const spv_instruction_t* inst,
   }
   auto functionType = find(inst->words[4]);
   spvCheck(!found(functionType), assert(0 && "Unreachable!"));
-  auto paramType = find(functionType->second.inst->words[paramIndex + 3]);
+  auto paramType = find(functionType->inst->words[paramIndex + 3]);
   spvCheck(!found(paramType), assert(0 && "Unreachable!"));
   spvCheck(
-      !spvOpcodeAreTypesEqual(resultType->second.inst, paramType->second.inst),
+      !spvOpcodeAreTypesEqual(resultType->inst, paramType->inst),
       DIAG(resultTypeIndex) << "OpFunctionParameter Result Type <id> '"
                             << inst->words[resultTypeIndex]
                             << "' does not match the OpTypeFunction parameter "
@@ -1245,7 +1334,7 @@ bool idUsage::isValid<SpvOpFunctionParameter>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpFunctionCall>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpFunctionCall>(const spv_instruction_view_t* inst,
                                          const spv_opcode_desc) {
   auto resultTypeIndex = 1;
   auto resultType = find(inst->words[resultTypeIndex]);
@@ -1261,24 +1350,24 @@ bool idUsage::isValid<SpvOpFunctionCall>(const spv_instruction_t* inst,
                                  << inst->words[functionIndex]
                                  << "' is not defined.";
            return false);
-  spvCheck(SpvOpFunction != function->second.opcode,
+  spvCheck(SpvOpFunction != function->opcode,
            DIAG(functionIndex) << "OpFunctionCall Function <id> '"
                                << inst->words[functionIndex]
                                << "' is not a function.";
            return false);
-  auto returnType = find(function->second.inst->words[1]);
+  auto returnType = find(function->inst->words[1]);
   spvCheck(!found(returnType), assert(0 && "Unreachable!"));
   spvCheck(
-      !spvOpcodeAreTypesEqual(returnType->second.inst, resultType->second.inst),
+      !spvOpcodeAreTypesEqual(returnType->inst, resultType->inst),
       DIAG(resultTypeIndex)
           << "OpFunctionCall Result Type <id> '" << inst->words[resultTypeIndex]
-          << "'s type does not match Function <id> '" << returnType->second.id
+          << "'s type does not match Function <id> '" << returnType->id
           << "'s return type.";
       return false);
-  auto functionType = find(function->second.inst->words[4]);
+  auto functionType = find(function->inst->words[4]);
   spvCheck(!found(functionType), assert(0 && "Unreachable!"));
   auto functionCallArgCount = inst->words.size() - 4;
-  auto functionParamCount = functionType->second.inst->words.size() - 3;
+  auto functionParamCount = functionType->inst->words.size() - 3;
   spvCheck(
       functionParamCount != functionCallArgCount,
       DIAG(inst->words.size() - 1)
@@ -1293,16 +1382,16 @@ bool idUsage::isValid<SpvOpFunctionCall>(const spv_instruction_t* inst,
                                    << inst->words[argumentIndex]
                                    << "' is not defined.";
              return false);
-    auto argumentType = find(argument->second.inst->words[1]);
+    auto argumentType = find(argument->inst->words[1]);
     spvCheck(!found(argumentType), assert(0 && "Unreachable!"));
-    auto parameterType = find(functionType->second.inst->words[paramIndex]);
+    auto parameterType = find(functionType->inst->words[paramIndex]);
     spvCheck(!found(parameterType), assert(0 && "Unreachable!"));
-    spvCheck(!spvOpcodeAreTypesEqual(argumentType->second.inst,
-                                     parameterType->second.inst),
+    spvCheck(!spvOpcodeAreTypesEqual(argumentType->inst,
+                                     parameterType->inst),
              DIAG(argumentIndex) << "OpFunctionCall Argument <id> '"
                                  << inst->words[argumentIndex]
                                  << "'s type does not match Function <id> '"
-                                 << parameterType->second.id
+                                 << parameterType->id
                                  << "'s parameter type.";
              return false);
   }
@@ -1311,56 +1400,56 @@ bool idUsage::isValid<SpvOpFunctionCall>(const spv_instruction_t* inst,
 
 #if 0
 template <>
-bool idUsage::isValid<OpConvertUToF>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpConvertUToF>(const spv_instruction_view_t *inst,
                                      const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpConvertFToS>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpConvertFToS>(const spv_instruction_view_t *inst,
                                      const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpConvertSToF>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpConvertSToF>(const spv_instruction_view_t *inst,
                                      const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpConvertUToF>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpConvertUToF>(const spv_instruction_view_t *inst,
                                      const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpUConvert>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpUConvert>(const spv_instruction_view_t *inst,
                                   const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpSConvert>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpSConvert>(const spv_instruction_view_t *inst,
                                   const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpFConvert>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpFConvert>(const spv_instruction_view_t *inst,
                                   const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpConvertPtrToU>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpConvertPtrToU>(const spv_instruction_view_t *inst,
                                        const spv_opcode_desc opcodeEntry) {
 }
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpConvertUToPtr>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpConvertUToPtr>(const spv_instruction_view_t *inst,
                                        const spv_opcode_desc opcodeEntry) {
 }
 #endif
@@ -1368,52 +1457,52 @@ bool idUsage::isValid<OpConvertUToPtr>(const spv_instruction_t *inst,
 #if 0
 template <>
 bool idUsage::isValid<OpPtrCastToGeneric>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGenericCastToPtr>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpBitcast>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpBitcast>(const spv_instruction_view_t *inst,
                                  const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGenericCastToPtrExplicit>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpSatConvertSToU>(const spv_instruction_t *inst) {}
+bool idUsage::isValid<OpSatConvertSToU>(const spv_instruction_view_t *inst) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpSatConvertUToS>(const spv_instruction_t *inst) {}
+bool idUsage::isValid<OpSatConvertUToS>(const spv_instruction_view_t *inst) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpVectorExtractDynamic>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpVectorInsertDynamic>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpVectorShuffle>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpVectorShuffle>(const spv_instruction_view_t *inst,
                                        const spv_opcode_desc opcodeEntry) {
 }
 #endif
@@ -1421,522 +1510,522 @@ bool idUsage::isValid<OpVectorShuffle>(const spv_instruction_t *inst,
 #if 0
 template <>
 bool idUsage::isValid<OpCompositeConstruct>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpCompositeExtract>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpCompositeInsert>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpCopyObject>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpCopyObject>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpTranspose>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpTranspose>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpSNegate>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpSNegate>(const spv_instruction_view_t *inst,
                                  const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpFNegate>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpFNegate>(const spv_instruction_view_t *inst,
                                  const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpNot>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpNot>(const spv_instruction_view_t *inst,
                              const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpIAdd>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpIAdd>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpFAdd>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpFAdd>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpISub>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpISub>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpFSub>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpFSub>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpIMul>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpIMul>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpFMul>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpFMul>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpUDiv>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpUDiv>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpSDiv>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpSDiv>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpFDiv>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpFDiv>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpUMod>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpUMod>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpSRem>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpSRem>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpSMod>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpSMod>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpFRem>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpFRem>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpFMod>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpFMod>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpVectorTimesScalar>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpMatrixTimesScalar>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpVectorTimesMatrix>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpMatrixTimesVector>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpMatrixTimesMatrix>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpOuterProduct>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpOuterProduct>(const spv_instruction_view_t *inst,
                                       const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpDot>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpDot>(const spv_instruction_view_t *inst,
                              const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpShiftRightLogical>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpShiftRightArithmetic>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpShiftLeftLogical>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpBitwiseOr>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpBitwiseOr>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpBitwiseXor>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpBitwiseXor>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpBitwiseAnd>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpBitwiseAnd>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAny>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAny>(const spv_instruction_view_t *inst,
                              const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAll>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAll>(const spv_instruction_view_t *inst,
                              const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpIsNan>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpIsNan>(const spv_instruction_view_t *inst,
                                const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpIsInf>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpIsInf>(const spv_instruction_view_t *inst,
                                const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpIsFinite>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpIsFinite>(const spv_instruction_view_t *inst,
                                   const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpIsNormal>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpIsNormal>(const spv_instruction_view_t *inst,
                                   const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpSignBitSet>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpSignBitSet>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpLessOrGreater>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpLessOrGreater>(const spv_instruction_view_t *inst,
                                        const spv_opcode_desc opcodeEntry) {
 }
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpOrdered>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpOrdered>(const spv_instruction_view_t *inst,
                                  const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpUnordered>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpUnordered>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpLogicalOr>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpLogicalOr>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpLogicalXor>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpLogicalXor>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpLogicalAnd>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpLogicalAnd>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpSelect>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpSelect>(const spv_instruction_view_t *inst,
                                 const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpIEqual>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpIEqual>(const spv_instruction_view_t *inst,
                                 const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpFOrdEqual>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpFOrdEqual>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpFUnordEqual>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpFUnordEqual>(const spv_instruction_view_t *inst,
                                      const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpINotEqual>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpINotEqual>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpFOrdNotEqual>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpFOrdNotEqual>(const spv_instruction_view_t *inst,
                                       const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpFUnordNotEqual>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpULessThan>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpULessThan>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpSLessThan>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpSLessThan>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpFOrdLessThan>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpFOrdLessThan>(const spv_instruction_view_t *inst,
                                       const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpFUnordLessThan>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpUGreaterThan>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpUGreaterThan>(const spv_instruction_view_t *inst,
                                       const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpSGreaterThan>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpSGreaterThan>(const spv_instruction_view_t *inst,
                                       const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpFOrdGreaterThan>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpFUnordGreaterThan>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpULessThanEqual>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpSLessThanEqual>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpFOrdLessThanEqual>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpFUnordLessThanEqual>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpUGreaterThanEqual>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpSGreaterThanEqual>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpFOrdGreaterThanEqual>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpFUnordGreaterThanEqual>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpDPdx>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpDPdx>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpDPdy>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpDPdy>(const spv_instruction_view_t *inst,
                               const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpFWidth>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpFWidth>(const spv_instruction_view_t *inst,
                                 const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpDPdxFine>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpDPdxFine>(const spv_instruction_view_t *inst,
                                   const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpDPdyFine>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpDPdyFine>(const spv_instruction_view_t *inst,
                                   const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpFwidthFine>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpFwidthFine>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpDPdxCoarse>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpDPdxCoarse>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpDPdyCoarse>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpDPdyCoarse>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpFwidthCoarse>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpFwidthCoarse>(const spv_instruction_view_t *inst,
                                       const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpPhi>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpPhi>(const spv_instruction_view_t *inst,
                              const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpLoopMerge>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpLoopMerge>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpSelectionMerge>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpBranch>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpBranch>(const spv_instruction_view_t *inst,
                                 const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpBranchConditional>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpSwitch>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpSwitch>(const spv_instruction_view_t *inst,
                                 const spv_opcode_desc opcodeEntry) {}
 #endif
 
 template <>
-bool idUsage::isValid<SpvOpReturnValue>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpReturnValue>(const spv_instruction_view_t* inst,
                                         const spv_opcode_desc) {
   auto valueIndex = 1;
   auto value = find(inst->words[valueIndex]);
@@ -1944,15 +2033,15 @@ bool idUsage::isValid<SpvOpReturnValue>(const spv_instruction_t* inst,
                                            << inst->words[valueIndex]
                                            << "' is not defined.";
            return false);
-  spvCheck(!spvOpcodeIsValue(value->second.opcode),
+  spvCheck(!spvOpcodeIsValue(value->opcode),
            DIAG(valueIndex) << "OpReturnValue Value <id> '"
                             << inst->words[valueIndex]
                             << "' does not represent a value.";
            return false);
-  auto valueType = find(value->second.inst->words[1]);
+  auto valueType = find(value->inst->words[1]);
   spvCheck(!found(valueType), assert(0 && "Unreachable!"));
   // NOTE: Find OpFunction
-  const spv_instruction_t* function = inst - 1;
+  const spv_instruction_view_t* function = inst - 1;
   while (firstInst != function) {
     spvCheck(SpvOpFunction == function->opcode, break);
     function--;
@@ -1962,18 +2051,18 @@ bool idUsage::isValid<SpvOpReturnValue>(const spv_instruction_t* inst,
            return false);
   auto returnType = find(function->words[1]);
   spvCheck(!found(returnType), assert(0 && "Unreachable!"));
-  if (SpvOpTypePointer == valueType->second.opcode) {
-    auto pointerValueType = find(valueType->second.inst->words[3]);
+  if (SpvOpTypePointer == valueType->opcode) {
+    auto pointerValueType = find(valueType->inst->words[3]);
     spvCheck(!found(pointerValueType), assert(0 && "Unreachable!"));
-    spvCheck(!spvOpcodeAreTypesEqual(returnType->second.inst,
-                                     pointerValueType->second.inst),
+    spvCheck(!spvOpcodeAreTypesEqual(returnType->inst,
+                                     pointerValueType->inst),
              DIAG(valueIndex)
                  << "OpReturnValue Value <id> '" << inst->words[valueIndex]
                  << "'s pointer type does not match OpFunction's return type.";
              return false);
   } else {
-    spvCheck(!spvOpcodeAreTypesEqual(returnType->second.inst,
-                                     valueType->second.inst),
+    spvCheck(!spvOpcodeAreTypesEqual(returnType->inst,
+                                     valueType->inst),
              DIAG(valueIndex)
                  << "OpReturnValue Value <id> '" << inst->words[valueIndex]
                  << "'s type does not match OpFunction's return type.";
@@ -1984,219 +2073,219 @@ bool idUsage::isValid<SpvOpReturnValue>(const spv_instruction_t* inst,
 
 #if 0
 template <>
-bool idUsage::isValid<OpLifetimeStart>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpLifetimeStart>(const spv_instruction_view_t *inst,
                                        const spv_opcode_desc opcodeEntry) {
 }
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpLifetimeStop>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpLifetimeStop>(const spv_instruction_view_t *inst,
                                       const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicInit>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicInit>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicLoad>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicLoad>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicStore>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicStore>(const spv_instruction_view_t *inst,
                                      const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpAtomicExchange>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpAtomicCompareExchange>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpAtomicCompareExchangeWeak>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpAtomicIIncrement>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpAtomicIDecrement>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicIAdd>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicIAdd>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicISub>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicISub>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicUMin>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicUMin>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicUMax>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicUMax>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicAnd>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicAnd>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicOr>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicOr>(const spv_instruction_view_t *inst,
                                   const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicXor>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicXor>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicIMin>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicIMin>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicIMax>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicIMax>(const spv_instruction_view_t *inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpEmitStreamVertex>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpEndStreamPrimitive>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGroupAsyncCopy>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGroupWaitEvents>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupAll>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupAll>(const spv_instruction_view_t *inst,
                                   const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupAny>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupAny>(const spv_instruction_view_t *inst,
                                   const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGroupBroadcast>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupIAdd>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupIAdd>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupFAdd>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupFAdd>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupFMin>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupFMin>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupUMin>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupUMin>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupSMin>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupSMin>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupFMax>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupFMax>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupUMax>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupUMax>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupSMax>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupSMax>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpEnqueueMarker>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpEnqueueMarker>(const spv_instruction_view_t *inst,
                                        const spv_opcode_desc opcodeEntry) {
 }
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpEnqueueKernel>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpEnqueueKernel>(const spv_instruction_view_t *inst,
                                        const spv_opcode_desc opcodeEntry) {
 }
 #endif
@@ -2204,168 +2293,168 @@ bool idUsage::isValid<OpEnqueueKernel>(const spv_instruction_t *inst,
 #if 0
 template <>
 bool idUsage::isValid<OpGetKernelNDrangeSubGroupCount>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGetKernelNDrangeMaxSubGroupSize>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGetKernelWorkGroupSize>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGetKernelPreferredWorkGroupSizeMultiple>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpRetainEvent>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpRetainEvent>(const spv_instruction_view_t *inst,
                                      const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpReleaseEvent>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpReleaseEvent>(const spv_instruction_view_t *inst,
                                       const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpCreateUserEvent>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpIsValidEvent>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpIsValidEvent>(const spv_instruction_view_t *inst,
                                       const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpSetUserEventStatus>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpCaptureEventProfilingInfo>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGetDefaultQueue>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpBuildNDRange>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpBuildNDRange>(const spv_instruction_view_t *inst,
                                       const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpReadPipe>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpReadPipe>(const spv_instruction_view_t *inst,
                                   const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpWritePipe>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpWritePipe>(const spv_instruction_view_t *inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpReservedReadPipe>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpReservedWritePipe>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpReserveReadPipePackets>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpReserveWritePipePackets>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpCommitReadPipe>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpCommitWritePipe>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpIsValidReserveId>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGetNumPipePackets>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGetMaxPipePackets>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGroupReserveReadPipePackets>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGroupReserveWritePipePackets>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGroupCommitReadPipe>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGroupCommitWritePipe>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const spv_instruction_view_t *inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #undef DIAG
 
-bool idUsage::isValid(const spv_instruction_t* inst) {
+bool idUsage::isValid(const spv_instruction_view_t* inst) {
   spv_opcode_desc opcodeEntry = nullptr;
   spvCheck(spvOpcodeTableValueLookup(opcodeTable, inst->opcode, &opcodeEntry),
            return false);
@@ -2592,15 +2681,114 @@ bool idUsage::isValid(const spv_instruction_t* inst) {
 }
 }  // anonymous namespace
 
+namespace {
+// A run of instructions whose IDs are checked together: the module scope
+// instructions before the first function, or one function.
+struct idShard {
+  uint64_t firstInst;
+  uint64_t endInst;
+  // The word offset of the first instruction
+  size_t firstWord;
+};
+
+// The outcome of checking the IDs of an idShard
+struct idShardResult {
+  bool failed;
+  spv_position_t position;
+  spv_diagnostic diagnostic;
+};
+
+// Checks the IDs of the functions of a module on threadCount threads.  Each
+// thread checks the next unchecked shard until all have been checked, or
+// until the remaining shards follow one which failed.  Every shard before
+// the first failed one is checked, so the error reported is the first in
+// module order, as when checking on one thread.
+//
+// NOTE: The shards are all known up front, so taking them in order from a
+// shared counter balances the load as well as work stealing would, without
+// per-thread queues.
+spv_result_t validateInstructionIDsInParallel(
+    const idIndex& index, const spv_instruction_view_t* pInsts,
+    const uint64_t instCount, const spv_opcode_table opcodeTable,
+    const spv_operand_table operandTable, const spv_ext_inst_table extInstTable,
+    const uint32_t threadCount, spv_position position, spv_diagnostic* pDiag) {
+  std::vector<idShard> shards;
+  size_t word = position->index;
+  for (uint64_t instIndex = 0; instIndex < instCount; ++instIndex) {
+    if (shards.empty() || SpvOpFunction == pInsts[instIndex].opcode) {
+      shards.push_back({instIndex, instIndex, word});
+    }
+    shards.back().endInst = instIndex + 1;
+    word += pInsts[instIndex].words.size();
+  }
+  if (shards.empty()) return SPV_SUCCESS;
+
+  std::vector<idShardResult> results(shards.size(),
+                                     idShardResult{false, *position, nullptr});
+  std::atomic<size_t> nextShard(0);
+  std::atomic<size_t> firstFailure(shards.size());
+  auto checkShards = [&]() {
+    for (size_t shardIndex = nextShard++;
+         shardIndex < shards.size() && shardIndex < firstFailure;
+         shardIndex = nextShard++) {
+      const idShard& shard = shards[shardIndex];
+      idShardResult& result = results[shardIndex];
+      result.position.index = shard.firstWord;
+      idUsage idUsage(opcodeTable, operandTable, extInstTable, index, pInsts,
+                      instCount, &result.position, &result.diagnostic);
+      for (uint64_t instIndex = shard.firstInst; instIndex < shard.endInst;
+           ++instIndex) {
+        if (!idUsage.isValid(&pInsts[instIndex])) {
+          result.failed = true;
+          size_t failure = firstFailure;
+          while (shardIndex < failure &&
+                 !firstFailure.compare_exchange_weak(failure, shardIndex)) {
+          }
+          break;
+        }
+        result.position.index += pInsts[instIndex].words.size();
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  const size_t helperCount =
+      std::min<size_t>(threadCount, shards.size()) - 1;
+  for (size_t helper = 0; helper < helperCount; ++helper) {
+    threads.emplace_back(checkShards);
+  }
+  checkShards();
+  for (auto& thread : threads) thread.join();
+
+  const size_t failure = firstFailure;
+  for (size_t shardIndex = 0; shardIndex < results.size(); ++shardIndex) {
+    if (shardIndex != failure) {
+      spvDiagnosticDestroy(results[shardIndex].diagnostic);
+    }
+  }
+  if (failure == shards.size()) return SPV_SUCCESS;
+  *position = results[failure].position;
+  *pDiag = results[failure].diagnostic;
+  return SPV_ERROR_INVALID_ID;
+}
+}  // anonymous namespace
+
 spv_result_t spvValidateInstructionIDs(
-    const spv_instruction_t* pInsts, const uint64_t instCount,
+    const spv_instruction_view_t* pInsts, const uint64_t instCount,
     const spv_id_info_t* pIdUses, const uint64_t idUsesCount,
     const spv_id_info_t* pIdDefs, const uint64_t idDefsCount,
-    const spv_opcode_table opcodeTable, const spv_operand_table operandTable,
-    const spv_ext_inst_table extInstTable, spv_position position,
-    spv_diagnostic* pDiag) {
-  idUsage idUsage(opcodeTable, operandTable, extInstTable, pIdUses, idUsesCount,
-                  pIdDefs, idDefsCount, pInsts, instCount, position, pDiag);
+    const uint32_t bound, const spv_opcode_table opcodeTable,
+    const spv_operand_table operandTable, const spv_ext_inst_table extInstTable,
+    const uint32_t threadCount, spv_position position, spv_diagnostic* pDiag) {
+  const idIndex index(pIdUses, idUsesCount, pIdDefs, idDefsCount, pInsts,
+                      instCount, bound);
+  if (threadCount > 1) {
+    return validateInstructionIDsInParallel(
+        index, pInsts, instCount, opcodeTable, operandTable, extInstTable,
+        threadCount, position, pDiag);
+  }
+  idUsage idUsage(opcodeTable, operandTable, extInstTable, index, pInsts,
+                  instCount, position, pDiag);
   for (uint64_t instIndex = 0; instIndex < instCount; ++instIndex) {
     spvCheck(!idUsage.isValid(&pInsts[instIndex]), return SPV_ERROR_INVALID_ID);
     position->index += pInsts[instIndex].words.size();
@@ -24,16 +24,19 @@
 // TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
 // MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
 
+#include "binary.h"
 #include "headers/spirv.h"
+#include "spirv_constant.h"
+#include "spirv_endian.h"
 #include "validate_types.h"
 
 #include <algorithm>
-#include <map>
+#include <cassert>
+#include <sstream>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
-using std::find;
 using std::string;
 using std::unordered_set;
 using std::vector;
@@ -111,25 +114,145 @@ const vector<vector<SpvOp>>& GetModuleOrder() {
 
   return moduleOrder;
 }
+
+// Marks opcodes which may not appear at module scope.
+const uint8_t kNotModuleScope = 0xff;
+
+// Returns a table mapping each opcode to the index of the section of
+// GetModuleOrder() in which it may appear, or to kNotModuleScope.
+const vector<uint8_t>& GetModuleSectionTable() {
+  static const vector<uint8_t> table = [] {
+    const vector<vector<SpvOp>>& order = GetModuleOrder();
+    size_t size = 0;
+    for (const auto& section : order) {
+      for (SpvOp op : section) size = std::max(size, size_t(op) + 1);
+    }
+    vector<uint8_t> sections(size, kNotModuleScope);
+    for (size_t i = 0; i < order.size(); ++i) {
+      for (SpvOp op : order[i]) sections[op] = static_cast<uint8_t>(i);
+    }
+    return sections;
+  }();
+  return table;
+}
+
+// Returns the index of the section of GetModuleOrder() in which op may
+// appear, or kNotModuleScope.
+uint8_t GetModuleSection(SpvOp op) {
+  const vector<uint8_t>& table = GetModuleSectionTable();
+  return size_t(op) < table.size() ? table[op] : kNotModuleScope;
+}
 }
 
 namespace libspirv {
 
+void IdSet::reset(uint32_t dense_bound) {
+  dense_.assign(dense_bound, false);
+  sparse_.clear();
+  size_ = 0;
+}
+
+bool IdSet::insert(uint32_t id) {
+  bool inserted;
+  if (id < dense_.size()) {
+    inserted = !dense_[id];
+    dense_[id] = true;
+  } else {
+    inserted = sparse_.insert(id).second;
+  }
+  size_ += inserted;
+  return inserted;
+}
+
+bool IdSet::erase(uint32_t id) {
+  bool erased;
+  if (id < dense_.size()) {
+    erased = dense_[id];
+    dense_[id] = false;
+  } else {
+    erased = sparse_.erase(id) != 0;
+  }
+  size_ -= erased;
+  return erased;
+}
+
+vector<uint32_t> IdSet::ids() const {
+  vector<uint32_t> out;
+  out.reserve(size_);
+  for (uint32_t id = 0; id < dense_.size() && out.size() < size_; ++id) {
+    if (dense_[id]) out.push_back(id);
+  }
+  const size_t num_dense = out.size();
+  out.insert(out.end(), sparse_.begin(), sparse_.end());
+  std::sort(out.begin() + num_dense, out.end());
+  return out;
+}
+
 ValidationState_t::ValidationState_t(spv_diagnostic* diagnostic,
                                      uint32_t options)
     : diagnostic_(diagnostic),
       instruction_counter_(0),
-      defined_ids_{},
-      unresolved_forward_ids_{},
+      defined_ids_(),
+      unresolved_forward_ids_(),
       validation_flags_(options),
-      operand_names_{},
+      words_(nullptr),
+      num_words_(0),
+      endian_(SPV_ENDIANNESS_LITTLE),
+      id_names_(),
       module_layout_order_stage_(0),
-      current_layout_stage_(ModuleLayoutSection::kModule) {}
+      current_layout_stage_(ModuleLayoutSection::kModule),
+      has_memory_model_(false),
+      current_function_has_body_(false),
+      has_function_definition_(false),
+      function_cfg_(),
+      instructions_(),
+      instruction_offset_(0),
+      next_instruction_offset_(SPV_INDEX_INSTRUCTION),
+      id_def_instruction_indices_(),
+      id_defs_(),
+      id_uses_() {}
+
+void ValidationState_t::reset(spv_diagnostic* diagnostic,
+                              uint32_t options) {
+  diagnostic_ = diagnostic;
+  instruction_counter_ = 0;
+  defined_ids_.reset(0);
+  unresolved_forward_ids_.reset(0);
+  validation_flags_ = options;
+  words_ = nullptr;
+  num_words_ = 0;
+  endian_ = SPV_ENDIANNESS_LITTLE;
+  id_names_.clear();
+  module_layout_order_stage_ = 0;
+  current_layout_stage_ = ModuleLayoutSection::kModule;
+  has_memory_model_ = false;
+  current_function_has_body_ = false;
+  has_function_definition_ = false;
+  function_cfg_.endFunction();
+  instructions_.clear();
+  instruction_offset_ = 0;
+  next_instruction_offset_ = SPV_INDEX_INSTRUCTION;
+  id_def_instruction_indices_.clear();
+  id_defs_.clear();
+  id_uses_.clear();
+}
+
+void ValidationState_t::setIdBound(uint32_t bound, size_t num_words) {
+  const uint32_t dense_bound = spvDenseIdBound(bound, num_words);
+  defined_ids_.reset(dense_bound);
+  unresolved_forward_ids_.reset(dense_bound);
+}
+
+void ValidationState_t::setModuleWords(const uint32_t* words,
+                                       size_t num_words,
+                                       spv_endianness_t endian) {
+  words_ = words;
+  num_words_ = num_words;
+  endian_ = endian;
+}
 
 spv_result_t ValidationState_t::defineId(uint32_t id) {
-  if (defined_ids_.find(id) == end(defined_ids_)) {
-    defined_ids_.insert(id);
-  } else {
+  if (!defined_ids_.insert(id)) {
     return diag(SPV_ERROR_INVALID_ID) << "ID cannot be assigned multiple times";
   }
   return SPV_SUCCESS;
@@ -145,15 +268,60 @@ spv_result_t ValidationState_t::removeIfForwardDeclared(uint32_t id) {
   return SPV_SUCCESS;
 }
 
-void ValidationState_t::assignNameToId(uint32_t id, string name) {
-  operand_names_[id] = name;
+void ValidationState_t::assignNameToId(uint32_t id, uint16_t name_offset) {
+  id_names_.push_back({id, false, instruction_offset_ + name_offset});
+}
+
+void ValidationState_t::assignMemberNameToId(uint32_t id,
+                                             uint16_t name_offset) {
+  id_names_.push_back({id, true, instruction_offset_ + name_offset});
+}
+
+void ValidationState_t::sortIdNames() {
+  // Keep the names of each ID in module order.
+  std::stable_sort(
+      id_names_.begin(), id_names_.end(),
+      [](const IdName& a, const IdName& b) { return a.id < b.id; });
+}
+
+const ValidationState_t::IdName* ValidationState_t::findIdName(
+    uint32_t id) const {
+  assert(std::is_sorted(
+      id_names_.begin(), id_names_.end(),
+      [](const IdName& a, const IdName& b) { return a.id < b.id; }));
+  const IdName key = {id, false, 0};
+  const auto range = std::equal_range(
+      id_names_.begin(), id_names_.end(), key,
+      [](const IdName& a, const IdName& b) { return a.id < b.id; });
+  // The last OpName wins.  Failing that, the last OpMemberName.
+  const IdName* member_name = nullptr;
+  for (auto it = range.second; it != range.first;) {
+    --it;
+    if (!it->is_member_name) return &*it;
+    if (!member_name) member_name = &*it;
+  }
+  return member_name;
+}
+
+string ValidationState_t::decodeString(size_t offset) const {
+  // Literal strings are packed four bytes to a word, from the low-order byte.
+  string out;
+  for (size_t i = offset; i < num_words_; ++i) {
+    const uint32_t word = spvFixWord(words_[i], endian_);
+    for (int shift = 0; shift < 32; shift += 8) {
+      const char c = static_cast<char>(word >> shift);
+      if (!c) return out;
+      out.push_back(c);
+    }
+  }
+  return out;
 }
 
 string ValidationState_t::getIdName(uint32_t id) const {
   std::stringstream out;
   out << id;
-  if (operand_names_.find(id) != end(operand_names_)) {
-    out << "[" << operand_names_.at(id) << "]";
+  if (const IdName* name = findIdName(id)) {
+    out << "[" << decodeString(name->offset) << "]";
   }
   return out.str();
 }
@@ -163,40 +331,92 @@ size_t ValidationState_t::unresolvedForwardIdCount() const {
 }
 
 vector<uint32_t> ValidationState_t::unresolvedForwardIds() const {
-  vector<uint32_t> out(begin(unresolved_forward_ids_),
-                       end(unresolved_forward_ids_));
-  return out;
+  return unresolved_forward_ids_.ids();
 }
 
 bool ValidationState_t::isDefinedId(uint32_t id) const {
-  return defined_ids_.find(id) != end(defined_ids_);
+  return defined_ids_.contains(id);
 }
 
 bool ValidationState_t::is_enabled(spv_validate_options_t flag) const {
   return (flag & validation_flags_) == flag;
 }
 
-// Increments the instruction count. Used for diagnostic
-int ValidationState_t::incrementInstructionCount() {
-  return instruction_counter_++;
+void ValidationState_t::beginInstruction(
+    const spv_parsed_instruction_t* inst) {
+  ++instruction_counter_;
+  instruction_offset_ = next_instruction_offset_;
+  next_instruction_offset_ += inst->num_words;
 }
 
 ModuleLayoutSection ValidationState_t::getLayoutStage() const {
   return current_layout_stage_;
 }
 
-void ValidationState_t::progressToNextLayoutStageOrder() {
-  module_layout_order_stage_ +=
-      module_layout_order_stage_ < GetModuleOrder().size();
-  if (module_layout_order_stage_ >= GetModuleOrder().size()) {
-    current_layout_stage_ = libspirv::ModuleLayoutSection::kFunction;
+ModuleLayoutSection ValidationState_t::progressToLayoutStageOf(SpvOp op) {
+  const uint8_t section = GetModuleSection(op);
+  if (section == kNotModuleScope || section < module_layout_order_stage_) {
+    current_layout_stage_ = ModuleLayoutSection::kFunction;
+  } else {
+    module_layout_order_stage_ = section;
+    has_memory_model_ |= op == SpvOpMemoryModel;
+  }
+  return current_layout_stage_;
+}
+
+bool ValidationState_t::hasMemoryModel() const { return has_memory_model_; }
+
+void ValidationState_t::beginFunction() { current_function_has_body_ = false; }
+
+void ValidationState_t::beginFunctionBody() {
+  current_function_has_body_ = true;
+}
+
+bool ValidationState_t::endFunction() {
+  const bool declaration_after_definition =
+      !current_function_has_body_ && has_function_definition_;
+  has_function_definition_ |= current_function_has_body_;
+  return !declaration_after_definition;
+}
+
+bool IsModuleScopeOpcode(SpvOp op) {
+  return GetModuleSection(op) != kNotModuleScope;
+}
+
+void ValidationState_t::recordInstruction(
+    const spv_parsed_instruction_t* inst) {
+  const size_t word_offset = instruction_offset_;
+  const size_t instruction_index = instructions_.size();
+  instructions_.push_back(
+      {inst->opcode, spv_word_view_t(inst->words, inst->num_words)});
+  for (uint16_t i = 0; i < inst->num_operands; ++i) {
+    const spv_parsed_operand_t& operand = inst->operands[i];
+    const uint32_t id = inst->words[operand.offset];
+    const spv_position_t position = {0, 0, word_offset + operand.offset};
+    if (SPV_OPERAND_TYPE_RESULT_ID == operand.type) {
+      id_defs_.push_back({id, inst->opcode, nullptr, position});
+      id_def_instruction_indices_.push_back(instruction_index);
+    } else if (SPV_OPERAND_TYPE_ID == operand.type) {
+      id_uses_.push_back({id, inst->opcode, nullptr, position});
+    }
+  }
+}
+
+FunctionCfg& ValidationState_t::functionCfg() { return function_cfg_; }
+
+const vector<spv_instruction_view_t>& ValidationState_t::instructions() const {
+  return instructions_;
+}
+
+const vector<spv_id_info_t>& ValidationState_t::idDefs() {
+  for (size_t i = 0; i < id_defs_.size(); ++i) {
+    id_defs_[i].inst = &instructions_[id_def_instruction_indices_[i]];
   }
+  return id_defs_;
 }
 
-bool ValidationState_t::isOpcodeInCurrentLayoutStage(SpvOp op) {
-  const vector<SpvOp>& currentStage =
-      GetModuleOrder()[module_layout_order_stage_];
-  return end(currentStage) != find(begin(currentStage), end(currentStage), op);
+const vector<spv_id_info_t>& ValidationState_t::idUses() const {
+  return id_uses_;
 }
 
 libspirv::DiagnosticStream ValidationState_t::diag(
@@ -29,9 +29,11 @@
 
 #include "binary.h"
 #include "diagnostic.h"
+#include "instruction.h"
 #include "libspirv/libspirv.h"
+#include "validate.h"
+#include "validate_cfg.h"
 
-#include <map>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -46,10 +48,60 @@ enum class ModuleLayoutSection {
   kFunction,  // < Function scope instructions are executed
 };
 
+// Returns true if op may appear in the module scope sections of a module.
+bool IsModuleScopeOpcode(SpvOp op);
+
+// A set of IDs.  IDs below a chosen bound are kept in a bitset, and any
+// others in a hash set.  Choose the bound from the module header to avoid
+// hashing in the common case.
+class IdSet {
+ public:
+  IdSet() : dense_(), sparse_(), size_(0) {}
+
+  // Removes all IDs, and keeps IDs less than dense_bound in a bitset.
+  void reset(uint32_t dense_bound);
+
+  // Adds the ID.  Returns true if it was not already in the set.
+  bool insert(uint32_t id);
+
+  // Removes the ID.  Returns true if it was in the set.
+  bool erase(uint32_t id);
+
+  // Returns true if the ID is in the set.
+  bool contains(uint32_t id) const {
+    return id < dense_.size() ? dense_[id] : sparse_.count(id) != 0;
+  }
+
+  // Returns the number of IDs in the set.
+  size_t size() const { return size_; }
+
+  // Returns the IDs in the set, in increasing order.
+  std::vector<uint32_t> ids() const;
+
+ private:
+  std::vector<bool> dense_;
+  std::unordered_set<uint32_t> sparse_;
+  size_t size_;
+};
+
 class ValidationState_t {
  public:
   ValidationState_t(spv_diagnostic* diag, uint32_t options);
 
+  // Discards the state of the previous module, to validate another one with
+  // the given diagnostic and options.  Storage allocated for the previous
+  // module is kept for reuse.
+  void reset(spv_diagnostic* diag, uint32_t options);
+
+  // Prepares to track the IDs of a module with the given ID bound, made of
+  // num_words words.
+  void setIdBound(uint32_t bound, size_t num_words);
+
+  // Sets the words of the module, in the given byte order.  Names of IDs are
+  // decoded from them when needed, so they must outlive this object.
+  void setModuleWords(const uint32_t* words, size_t num_words,
+                      spv_endianness_t endian);
+
   // Defines the \p id for the module
   spv_result_t defineId(uint32_t id);
 
@@ -59,8 +111,19 @@ class ValidationState_t {
   // Removes a forward declared ID if it has been defined
   spv_result_t removeIfForwardDeclared(uint32_t id);
 
-  // Assigns a name to an ID
-  void assignNameToId(uint32_t id, std::string name);
+  // Assigns the literal string at word offset name_offset of the current
+  // instruction to the ID as its name.  The string is not decoded until the
+  // name is needed.
+  void assignNameToId(uint32_t id, uint16_t name_offset);
+
+  // Assigns the literal string at word offset name_offset of the current
+  // instruction to the ID as the name of one of its members.  It is only used
+  // for an ID without a name.
+  void assignMemberNameToId(uint32_t id, uint16_t name_offset);
+
+  // Sorts the names assigned to IDs so far, so that getIdName can find them.
+  // Must be called after names are assigned and before getIdName is.
+  void sortIdNames();
 
   // Returns a string representation of the ID in the format <id>[Name] where
   // the <id> is the numeric valid of the id and the Name is a name assigned by
@@ -80,35 +143,89 @@ class ValidationState_t {
   // validation instruction
   bool is_enabled(spv_validate_options_t flag) const;
 
-  // Increments the instruction count. Used for diagnostic
-  int incrementInstructionCount();
+  // Advances to the next instruction of the module.  Used for diagnostics and
+  // to locate the operands of the instruction in the module.
+  void beginInstruction(const spv_parsed_instruction_t* inst);
 
   // Returns the current layout section which is being processed
   ModuleLayoutSection getLayoutStage() const;
 
-  // Increments the module_layout_order_stage_
-  void progressToNextLayoutStageOrder();
+  // Moves to the module scope section in which op may appear, if that is not
+  // before the current one.  Otherwise moves to the function section.
+  // Returns the resulting layout section.
+  ModuleLayoutSection progressToLayoutStageOf(SpvOp op);
 
-  // Determines if the op instruction is part of the current stage
-  bool isOpcodeInCurrentLayoutStage(SpvOp op);
+  // Returns true if an OpMemoryModel instruction has been processed at
+  // module scope.
+  bool hasMemoryModel() const;
+
+  // Records the start of a function.
+  void beginFunction();
+
+  // Records that the current function has a body, and so is a definition
+  // rather than a declaration.
+  void beginFunctionBody();
+
+  // Records the end of the current function.  Returns false if it is a
+  // declaration following a function definition.
+  bool endFunction();
 
   libspirv::DiagnosticStream diag(spv_result_t error_code) const;
 
+  // Returns the control flow graph of the current function, for the SSA
+  // validation pass.
+  FunctionCfg& functionCfg();
+
+  // Records the next instruction of the module, and the IDs it defines and
+  // uses, for the ID validation pass.  The instruction's words are not
+  // copied, so they must be in host byte order and outlive this object.
+  void recordInstruction(const spv_parsed_instruction_t* inst);
+
+  // Returns the instructions recorded by recordInstruction, in module order.
+  const std::vector<spv_instruction_view_t>& instructions() const;
+
+  // Returns the ID definitions recorded by recordInstruction, in module
+  // order, with their inst members pointing into instructions().  Call it
+  // after all instructions have been recorded.
+  const std::vector<spv_id_info_t>& idDefs();
+
+  // Returns the ID uses recorded by recordInstruction, in module order.
+  const std::vector<spv_id_info_t>& idUses() const;
+
  private:
   spv_diagnostic* diagnostic_;
   // Tracks the number of instructions evaluated by the validator
   int instruction_counter_;
 
   // All IDs which have been defined
-  std::unordered_set<uint32_t> defined_ids_;
+  IdSet defined_ids_;
 
   // IDs which have been forward declared but have not been defined
-  std::unordered_set<uint32_t> unresolved_forward_ids_;
+  IdSet unresolved_forward_ids_;
 
   // Validation options to determine the passes to execute
   uint32_t validation_flags_;
 
-  std::map<uint32_t, std::string> operand_names_;
+  // The word offset in words_ of a literal string naming an ID
+  struct IdName {
+    uint32_t id;
+    bool is_member_name;
+    size_t offset;
+  };
+
+  // Returns the name of the ID, or nullptr if it has none.
+  const IdName* findIdName(uint32_t id) const;
+
+  // Returns the literal string at word offset offset of the module.
+  std::string decodeString(size_t offset) const;
+
+  // The words of the module
+  const uint32_t* words_;
+  size_t num_words_;
+  spv_endianness_t endian_;
+
+  // Names assigned to IDs, sorted by ID by sortIdNames
+  std::vector<IdName> id_names_;
 
   // The stage which is being processed by the validation. Partially based on
   // Section 2.4. Logical Layout of a Module
@@ -116,6 +233,30 @@ class ValidationState_t {
 
   // The section of the code being processed
   ModuleLayoutSection current_layout_stage_;
+
+  // True if the module has an OpMemoryModel instruction at module scope
+  bool has_memory_model_;
+
+  // True if the current function has a body
+  bool current_function_has_body_;
+
+  // True if a function definition has ended
+  bool has_function_definition_;
+
+  // The control flow graph of the current function
+  FunctionCfg function_cfg_;
+
+  // The instructions of the module, and the IDs they define and use.
+  std::vector<spv_instruction_view_t> instructions_;
+  // The word offsets of the current and next instructions of the module.
+  size_t instruction_offset_;
+  size_t next_instruction_offset_;
+  // Indices into instructions_ of the instructions defining each entry of
+  // id_defs_.  Pointers to the instructions are only stable once all of them
+  // have been recorded.
+  std::vector<size_t> id_def_instruction_indices_;
+  std::vector<spv_id_info_t> id_defs_;
+  std::vector<spv_id_info_t> id_uses_;
 };
 }
 
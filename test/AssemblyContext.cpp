@@ -26,12 +26,15 @@
 
 #include "UnitSPIRV.h"
 
+#include <string>
 #include <vector>
 #include <gmock/gmock.h>
 
 #include "source/instruction.h"
 
 using libspirv::AssemblyContext;
+using libspirv::NamedIdTable;
+using libspirv::TextToken;
 using spvtest::AutoText;
 using spvtest::Concatenate;
 using ::testing::Eq;
@@ -85,4 +88,38 @@ INSTANTIATE_TEST_CASE_P(
     }));
 // clang-format on
 
+TEST(NamedIdAssignOrGet, AssignsIdsInOrderOfAppearance) {
+  AssemblyContext context(AutoText(""), nullptr);
+  EXPECT_EQ(1u, context.spvNamedIdAssignOrGet("foo"));
+  EXPECT_EQ(2u, context.spvNamedIdAssignOrGet("42"));
+  EXPECT_EQ(1u, context.spvNamedIdAssignOrGet("foo"));
+  EXPECT_EQ(3u, context.spvNamedIdAssignOrGet("fo"));
+  EXPECT_EQ(4u, context.spvNamedIdAssignOrGet("foo2"));
+  EXPECT_EQ(2u, context.spvNamedIdAssignOrGet("42"));
+  EXPECT_EQ(5u, context.getBound());
+}
+
+TEST(NamedIdTable, ManyNamesSharingPrefixes) {
+  // Names of many lengths, most sharing a long prefix, enough to make the
+  // table grow several times.
+  std::vector<std::string> names;
+  for (int i = 0; i < 5000; ++i)
+    names.push_back("a_long_shared_prefix_" + std::to_string(i));
+  for (int i = 0; i < 100; ++i) names.push_back(std::string(i, 'x'));
+
+  NamedIdTable table;
+  for (size_t i = 0; i < names.size(); ++i) {
+    const TextToken name(names[i].data(), names[i].size());
+    EXPECT_EQ(i + 1, table.findOrInsert(name, uint32_t(i + 1)));
+  }
+  EXPECT_EQ(names.size(), table.size());
+  for (size_t i = 0; i < names.size(); ++i) {
+    // A copy of the name finds the same entry.
+    const std::string copy = names[i];
+    const TextToken name(copy.data(), copy.size());
+    EXPECT_EQ(i + 1, table.findOrInsert(name, 99999));
+  }
+  EXPECT_EQ(names.size(), table.size());
+}
+
 }  // anonymous namespace
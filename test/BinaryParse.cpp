@@ -264,6 +264,39 @@ TEST_F(BinaryParseTest, NullInstructionCallbackIsIgnored) {
   EXPECT_EQ(nullptr, diagnostic_);
 }
 
+TEST_F(BinaryParseTest, OppositeEndianModuleHasInstructionWordsConverted) {
+  auto binary = CompileSuccessfully("%1 = OpTypeVoid %2 = OpTypeInt 32 1");
+  for (auto& word : binary) {
+    word = (word >> 24) | ((word >> 8) & 0xff00) | ((word << 8) & 0xff0000) |
+           (word << 24);
+  }
+  InSequence calls_expected_in_specific_order;
+  EXPECT_HEADER(3).WillOnce(Return(SPV_SUCCESS));
+  EXPECT_CALL(client_, Instruction(MakeParsedVoidTypeInstruction(1)))
+      .WillOnce(Return(SPV_SUCCESS));
+  EXPECT_CALL(client_, Instruction(MakeParsedInt32TypeInstruction(2)))
+      .WillOnce(Return(SPV_SUCCESS));
+  Parse(binary, SPV_SUCCESS);
+  EXPECT_EQ(nullptr, diagnostic_);
+}
+
+// The parser keeps per-ID information in flat arrays when the header's ID
+// bound is plausible, and in hash maps otherwise.  Either way, the parse
+// must not depend on the stated bound.
+TEST_F(BinaryParseTest, IdInformationDoesNotDependOnStatedBound) {
+  for (uint32_t bound : {0u, 2u, 0xffffffffu}) {
+    auto binary = CompileSuccessfully(
+        "%1 = OpTypeInt 32 0 %2 = OpConstant %1 42 %3 = OpConstant %1 43");
+    binary[SPV_INDEX_BOUND] = bound;
+    EXPECT_HEADER(bound).WillOnce(Return(SPV_SUCCESS));
+    EXPECT_CALL(client_, Instruction(_))
+        .Times(3)
+        .WillRepeatedly(Return(SPV_SUCCESS));
+    Parse(binary, SPV_SUCCESS);
+    EXPECT_EQ(nullptr, diagnostic_);
+  }
+}
+
 // Check the result of multiple instruction callbacks.
 //
 // This test exercises non-default values for the following members of the
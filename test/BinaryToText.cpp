@@ -163,6 +163,120 @@ TEST_F(BinaryToText, InvalidDiagnostic) {
                             SPV_BINARY_TO_TEXT_OPTION_NONE, &text, nullptr));
 }
 
+// Appends the text chunks to the std::string in user_data.
+spv_result_t AppendToString(void* user_data, const char* text, size_t length) {
+  static_cast<std::string*>(user_data)->append(text, length);
+  return SPV_SUCCESS;
+}
+
+// Fails on the first chunk.
+spv_result_t FailToWrite(void*, const char*, size_t) {
+  return SPV_REQUESTED_TERMINATION;
+}
+
+TEST_F(BinaryToText, StreamMatchesText) {
+  const uint32_t all_options[] = {
+      SPV_BINARY_TO_TEXT_OPTION_NONE, SPV_BINARY_TO_TEXT_OPTION_INDENT,
+      SPV_BINARY_TO_TEXT_OPTION_PRINT | SPV_BINARY_TO_TEXT_OPTION_COLOR};
+  for (uint32_t options : all_options) {
+    spv_text text = nullptr;
+    spv_diagnostic diagnostic = nullptr;
+    const uint32_t text_options = options & ~SPV_BINARY_TO_TEXT_OPTION_PRINT &
+                                  ~SPV_BINARY_TO_TEXT_OPTION_COLOR;
+    ASSERT_EQ(SPV_SUCCESS,
+              spvBinaryToText(context, binary->code, binary->wordCount,
+                              text_options, &text, &diagnostic));
+    std::string streamed;
+    EXPECT_EQ(SPV_SUCCESS,
+              spvBinaryToTextStream(context, binary->code, binary->wordCount,
+                                    options, &streamed, AppendToString,
+                                    &diagnostic));
+    EXPECT_THAT(streamed, Eq(std::string(text->str, text->length)));
+    spvTextDestroy(text);
+  }
+}
+
+TEST_F(BinaryToText, StreamWriteFailureStopsDisassembly) {
+  spv_diagnostic diagnostic = nullptr;
+  EXPECT_EQ(SPV_REQUESTED_TERMINATION,
+            spvBinaryToTextStream(context, binary->code, binary->wordCount,
+                                  SPV_BINARY_TO_TEXT_OPTION_NONE, nullptr,
+                                  FailToWrite, &diagnostic));
+  EXPECT_EQ(nullptr, diagnostic);
+}
+
+TEST_F(BinaryToText, StreamInvalidArguments) {
+  spv_diagnostic diagnostic = nullptr;
+  std::string streamed;
+  EXPECT_EQ(SPV_ERROR_INVALID_POINTER,
+            spvBinaryToTextStream(context, binary->code, binary->wordCount,
+                                  SPV_BINARY_TO_TEXT_OPTION_NONE, &streamed,
+                                  nullptr, &diagnostic));
+  EXPECT_EQ(SPV_ERROR_INVALID_DIAGNOSTIC,
+            spvBinaryToTextStream(context, binary->code, binary->wordCount,
+                                  SPV_BINARY_TO_TEXT_OPTION_NONE, &streamed,
+                                  AppendToString, nullptr));
+}
+
+TEST_F(BinaryToText, BufferMatchesText) {
+  const uint32_t all_options[] = {
+      SPV_BINARY_TO_TEXT_OPTION_NONE, SPV_BINARY_TO_TEXT_OPTION_INDENT,
+      SPV_BINARY_TO_TEXT_OPTION_PRINT | SPV_BINARY_TO_TEXT_OPTION_COLOR};
+  for (uint32_t options : all_options) {
+    spv_text text = nullptr;
+    spv_diagnostic diagnostic = nullptr;
+    const uint32_t text_options = options & ~SPV_BINARY_TO_TEXT_OPTION_PRINT &
+                                  ~SPV_BINARY_TO_TEXT_OPTION_COLOR;
+    ASSERT_EQ(SPV_SUCCESS,
+              spvBinaryToText(context, binary->code, binary->wordCount,
+                              text_options, &text, &diagnostic));
+    const std::string expected(text->str, text->length);
+    spvTextDestroy(text);
+
+    // Asking with no buffer reports the length of the text.
+    size_t length = 0;
+    ASSERT_EQ(SPV_ERROR_BUFFER_TOO_SMALL,
+              spvBinaryToTextBuffer(context, binary->code, binary->wordCount,
+                                    options, nullptr, 0, &length,
+                                    &diagnostic));
+    EXPECT_EQ(expected.size(), length);
+
+    // The text fits, but its terminator does not.
+    std::vector<char> buffer(length);
+    ASSERT_EQ(SPV_ERROR_BUFFER_TOO_SMALL,
+              spvBinaryToTextBuffer(context, binary->code, binary->wordCount,
+                                    options, buffer.data(), buffer.size(),
+                                    &length, &diagnostic));
+    EXPECT_EQ(expected.size(), length);
+
+    buffer.assign(length + 1, 'x');
+    ASSERT_EQ(SPV_SUCCESS,
+              spvBinaryToTextBuffer(context, binary->code, binary->wordCount,
+                                    options, buffer.data(), buffer.size(),
+                                    &length, &diagnostic));
+    EXPECT_EQ(expected.size(), length);
+    EXPECT_THAT(std::string(buffer.data()), Eq(expected));
+  }
+}
+
+TEST_F(BinaryToText, BufferInvalidArguments) {
+  spv_diagnostic diagnostic = nullptr;
+  char buffer[16];
+  size_t length = 0;
+  EXPECT_EQ(SPV_ERROR_INVALID_POINTER,
+            spvBinaryToTextBuffer(context, binary->code, binary->wordCount,
+                                  SPV_BINARY_TO_TEXT_OPTION_NONE, buffer, 16,
+                                  nullptr, &diagnostic));
+  EXPECT_EQ(SPV_ERROR_INVALID_POINTER,
+            spvBinaryToTextBuffer(context, binary->code, binary->wordCount,
+                                  SPV_BINARY_TO_TEXT_OPTION_NONE, nullptr, 16,
+                                  &length, &diagnostic));
+  EXPECT_EQ(SPV_ERROR_INVALID_DIAGNOSTIC,
+            spvBinaryToTextBuffer(context, binary->code, binary->wordCount,
+                                  SPV_BINARY_TO_TEXT_OPTION_NONE, buffer, 16,
+                                  &length, nullptr));
+}
+
 struct FailedDecodeCase {
   std::string source_text;
   std::vector<uint32_t> appended_instruction;
@@ -45,4 +45,60 @@ TEST(DiagnosticStream, ConversionToResultType) {
             spv_result_t(DiagnosticStream({}, 0, SPV_FAILED_MATCH)));
 }
 
+// Counts the number of times it is formatted.
+struct FormatCounter {
+  int* count;
+};
+
+std::ostream& operator<<(std::ostream& os, const FormatCounter& counter) {
+  ++*counter.count;
+  return os << "counted";
+}
+
+TEST(DiagnosticStream, EmitsMessageOnError) {
+  spv_diagnostic diagnostic = nullptr;
+  int count = 0;
+  {
+    DiagnosticStream({1, 2, 3}, &diagnostic, SPV_ERROR_INVALID_TEXT)
+        << "value " << 42 << " " << FormatCounter{&count};
+  }
+  ASSERT_NE(nullptr, diagnostic);
+  EXPECT_STREQ("value 42 counted", diagnostic->error);
+  EXPECT_EQ(3u, diagnostic->position.index);
+  EXPECT_EQ(1, count);
+  spvDiagnosticDestroy(diagnostic);
+}
+
+TEST(DiagnosticStream, FailedMatchFormatsNothing) {
+  spv_diagnostic diagnostic = nullptr;
+  int count = 0;
+  {
+    DiagnosticStream({}, &diagnostic, SPV_FAILED_MATCH)
+        << "value " << FormatCounter{&count};
+  }
+  EXPECT_EQ(nullptr, diagnostic);
+  EXPECT_EQ(0, count);
+}
+
+TEST(DiagnosticStream, NullDiagnosticFormatsNothing) {
+  int count = 0;
+  EXPECT_EQ(SPV_ERROR_INVALID_BINARY,
+            spv_result_t(DiagnosticStream({}, nullptr, SPV_ERROR_INVALID_BINARY)
+                         << FormatCounter{&count}));
+  EXPECT_EQ(0, count);
+}
+
+TEST(DiagnosticStream, MovedStreamEmitsWholeMessageOnce) {
+  spv_diagnostic diagnostic = nullptr;
+  {
+    DiagnosticStream first({}, &diagnostic, SPV_ERROR_INVALID_ID);
+    first << "first ";
+    DiagnosticStream second(std::move(first));
+    second << "second";
+  }
+  ASSERT_NE(nullptr, diagnostic);
+  EXPECT_STREQ("first second", diagnostic->error);
+  spvDiagnosticDestroy(diagnostic);
+}
+
 }  // anonymous namespace
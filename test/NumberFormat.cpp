@@ -0,0 +1,166 @@
+// Copyright (c) 2016 The Khronos Group Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and/or associated documentation files (the
+// "Materials"), to deal in the Materials without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Materials, and to
+// permit persons to whom the Materials are furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Materials.
+//
+// MODIFICATIONS TO THIS FILE MAY MEAN IT NO LONGER ACCURATELY REFLECTS
+// KHRONOS STANDARDS. THE UNMODIFIED, NORMATIVE VERSIONS OF KHRONOS
+// SPECIFICATIONS AND HEADER INFORMATION ARE LOCATED AT
+//    https://www.khronos.org/registry/
+//
+// THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+
+#include <clocale>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <gmock/gmock.h>
+#include "UnitSPIRV.h"
+#include "util/hex_float.h"
+#include "util/number_format.h"
+
+namespace {
+using ::testing::Eq;
+using spvutils::BitwiseCast;
+using spvutils::FloatProxy;
+
+// Formats the value with the given formatter into a string.
+template <typename T, typename Formatter>
+std::string Format(Formatter formatter, T value) {
+  char buffer[spvutils::kNumberFormatBufferSize];
+  return std::string(buffer, formatter(value, buffer));
+}
+
+// Formats the value the way the disassembler used to: with a std::ostream.
+template <typename T>
+std::string FormatWithStream(T value) {
+  std::ostringstream ss;
+  ss << value;
+  return ss.str();
+}
+
+TEST(NumberFormat, UnsignedMatchesStream) {
+  const uint64_t values[] = {0,
+                             1,
+                             9,
+                             10,
+                             99,
+                             100,
+                             101,
+                             999,
+                             1000,
+                             4294967295u,
+                             4294967296u,
+                             std::numeric_limits<uint64_t>::max() - 1,
+                             std::numeric_limits<uint64_t>::max()};
+  for (uint64_t value : values) {
+    EXPECT_THAT(Format(spvutils::FormatUnsigned, value),
+                Eq(FormatWithStream(value)));
+  }
+  std::mt19937_64 random(1);
+  for (int i = 0; i < 10000; ++i) {
+    const uint64_t value = random() >> (i % 64);
+    EXPECT_THAT(Format(spvutils::FormatUnsigned, value),
+                Eq(FormatWithStream(value)));
+  }
+}
+
+TEST(NumberFormat, SignedMatchesStream) {
+  const int64_t values[] = {0,
+                            1,
+                            -1,
+                            -9,
+                            -10,
+                            std::numeric_limits<int32_t>::min(),
+                            std::numeric_limits<int32_t>::max(),
+                            std::numeric_limits<int64_t>::min(),
+                            std::numeric_limits<int64_t>::max()};
+  for (int64_t value : values) {
+    EXPECT_THAT(Format(spvutils::FormatSigned, value),
+                Eq(FormatWithStream(value)));
+  }
+  std::mt19937_64 random(2);
+  for (int i = 0; i < 10000; ++i) {
+    const int64_t value = int64_t(random()) >> (i % 64);
+    EXPECT_THAT(Format(spvutils::FormatSigned, value),
+                Eq(FormatWithStream(value)));
+  }
+}
+
+// Checks that formatting the float with the given bits matches the
+// FloatProxy stream output, for zero and normal values.
+template <typename T>
+void ExpectDecimalFloatMatchesStream(typename FloatProxy<T>::uint_type bits) {
+  const T value = BitwiseCast<T>(bits);
+  const int kind = std::fpclassify(value);
+  if (kind != FP_ZERO && kind != FP_NORMAL) return;
+  EXPECT_THAT(Format(spvutils::FormatDecimalFloat<T>, value),
+              Eq(FormatWithStream(FloatProxy<T>(value))))
+      << std::hex << bits;
+}
+
+TEST(NumberFormat, FloatMatchesStream) {
+  const float values[] = {0.0f,     -0.0f,      1.0f,    -1.0f,  0.5f,
+                          0.1f,     3.14159f,   1e6f,    999999.0f,
+                          1000000.0f, 123456.5f, 1e-6f,   1e-5f,
+                          1e38f,    -2.5e-20f,  16777216.0f,
+                          std::numeric_limits<float>::max(),
+                          std::numeric_limits<float>::min()};
+  for (float value : values) {
+    ExpectDecimalFloatMatchesStream<float>(BitwiseCast<uint32_t>(value));
+  }
+  std::mt19937 random(3);
+  for (int i = 0; i < 100000; ++i) {
+    ExpectDecimalFloatMatchesStream<float>(random());
+  }
+  // Small integers, which take the fast path.
+  for (int i = -1000; i <= 1000; ++i) {
+    ExpectDecimalFloatMatchesStream<float>(
+        BitwiseCast<uint32_t>(float(i) * 997.0f));
+  }
+}
+
+TEST(NumberFormat, DoubleMatchesStream) {
+  const double values[] = {0.0,   -0.0,  1.0,   -1.0,  0.1,   1e15,
+                           1e15 - 1, 1e15 + 2, 123456789012345.5, 1e-300,
+                           std::numeric_limits<double>::max(),
+                           std::numeric_limits<double>::min()};
+  for (double value : values) {
+    ExpectDecimalFloatMatchesStream<double>(BitwiseCast<uint64_t>(value));
+  }
+  std::mt19937_64 random(4);
+  for (int i = 0; i < 100000; ++i) {
+    ExpectDecimalFloatMatchesStream<double>(random());
+  }
+}
+
+TEST(NumberFormat, FloatIgnoresCLocale) {
+  const std::string saved = std::setlocale(LC_NUMERIC, nullptr);
+  if (!std::setlocale(LC_NUMERIC, "de_DE.UTF-8") &&
+      !std::setlocale(LC_NUMERIC, "fr_FR.UTF-8")) {
+    return;  // No locale with a different decimal point is installed.
+  }
+  EXPECT_THAT(Format(spvutils::FormatDecimalFloat<float>, 2.5f), Eq("2.5"));
+  EXPECT_THAT(Format(spvutils::FormatDecimalFloat<double>, -1.25e-10),
+              Eq("-1.25e-10"));
+  std::setlocale(LC_NUMERIC, saved.c_str());
+}
+
+}  // anonymous namespace
@@ -35,8 +35,78 @@ TEST(OpcodeTableGet, Default) {
   ASSERT_NE(nullptr, table->entries);
 }
 
+TEST(OpcodeTableGet, TableIsShared) {
+  spv_opcode_table first;
+  spv_opcode_table second;
+  ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableGet(&first));
+  ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableGet(&second));
+  EXPECT_EQ(first, second);
+}
+
 TEST(OpcodeTableGet, InvalidPointerTable) {
   ASSERT_EQ(SPV_ERROR_INVALID_POINTER, spvOpcodeTableGet(nullptr));
 }
 
+TEST(OpcodeTableLookup, EveryEntryIsFoundByName) {
+  spv_opcode_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableGet(&table));
+  for (uint32_t i = 0; i < table->count; ++i) {
+    spv_opcode_desc entry = nullptr;
+    ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableNameLookup(
+                               table, table->entries[i].name, &entry));
+    EXPECT_EQ(&table->entries[i], entry);
+  }
+}
+
+TEST(OpcodeTableLookup, EveryEntryIsFoundByValue) {
+  spv_opcode_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableGet(&table));
+  for (uint32_t i = 0; i < table->count; ++i) {
+    spv_opcode_desc entry = nullptr;
+    ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableValueLookup(
+                               table, table->entries[i].opcode, &entry));
+    EXPECT_EQ(table->entries[i].opcode, entry->opcode);
+  }
+}
+
+TEST(OpcodeTableLookup, UnknownNameIsRejected) {
+  spv_opcode_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableGet(&table));
+  spv_opcode_desc entry = nullptr;
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOpcodeTableNameLookup(table, "", &entry));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOpcodeTableNameLookup(table, "OpNop", &entry));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOpcodeTableNameLookup(table, "No", &entry));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOpcodeTableNameLookup(table, "Nopx", &entry));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOpcodeTableNameLookup(table, "zzz", &entry));
+}
+
+TEST(OpcodeTableLookup, NameWithEmbeddedNullIsRejected) {
+  spv_opcode_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableGet(&table));
+  spv_opcode_desc entry = nullptr;
+  const char text[] = "Nop\0\0";
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOpcodeTableNameLookup(table, text, 5, &entry));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOpcodeTableNameLookup(table, text, 4, &entry));
+  EXPECT_EQ(SPV_SUCCESS, spvOpcodeTableNameLookup(table, text, 3, &entry));
+  EXPECT_EQ(SpvOpNop, entry->opcode);
+}
+
+TEST(OpcodeTableLookup, UnknownValueIsRejected) {
+  spv_opcode_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableGet(&table));
+  spv_opcode_desc entry = nullptr;
+  // Opcode 9 is a hole in the opcode numbering.
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOpcodeTableValueLookup(table, SpvOp(9), &entry));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOpcodeTableValueLookup(table, SpvOp(0xffff), &entry));
+}
+
 }  // anonymous namespace
@@ -49,4 +49,86 @@ TEST(OperandString, AllAreDefinedExceptVariable) {
   }
 }
 
+TEST(OperandTableLookup, EveryEntryIsFoundByNameAndValue) {
+  spv_operand_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOperandTableGet(&table));
+  for (uint32_t i = 0; i < table->count; ++i) {
+    const spv_operand_desc_group_t& group = table->types[i];
+    for (uint32_t j = 0; j < group.count; ++j) {
+      const spv_operand_desc_t& expected = group.entries[j];
+      spv_operand_desc entry = nullptr;
+      ASSERT_EQ(SPV_SUCCESS,
+                spvOperandTableNameLookup(table, group.type, expected.name,
+                                          strlen(expected.name), &entry))
+          << expected.name;
+      EXPECT_STREQ(expected.name, entry->name);
+      EXPECT_EQ(expected.value, entry->value);
+      ASSERT_EQ(SPV_SUCCESS, spvOperandTableValueLookup(table, group.type,
+                                                        expected.value, &entry))
+          << expected.name;
+      EXPECT_EQ(expected.value, entry->value);
+    }
+  }
+}
+
+TEST(OperandTableLookup, NameLookupUsesOnlyTheGivenLength) {
+  spv_operand_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOperandTableGet(&table));
+  spv_operand_desc entry = nullptr;
+  const char* text = "Logical|Physical32";
+  ASSERT_EQ(SPV_SUCCESS,
+            spvOperandTableNameLookup(table, SPV_OPERAND_TYPE_ADDRESSING_MODEL,
+                                      text, 7, &entry));
+  EXPECT_EQ(uint32_t(SpvAddressingModelLogical), entry->value);
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOperandTableNameLookup(table, SPV_OPERAND_TYPE_ADDRESSING_MODEL,
+                                      text, 6, &entry));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOperandTableNameLookup(table, SPV_OPERAND_TYPE_ADDRESSING_MODEL,
+                                      text, 8, &entry));
+}
+
+TEST(OperandTableLookup, NameWithEmbeddedNullIsRejected) {
+  spv_operand_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOperandTableGet(&table));
+  // The same table, without its index, is searched entry by entry.
+  const spv_operand_table_t unindexed = {table->count, table->types, nullptr};
+  const char text[] = "Logical\0\0";
+  for (spv_operand_table t : {table, &unindexed}) {
+    spv_operand_desc entry = nullptr;
+    EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+              spvOperandTableNameLookup(t, SPV_OPERAND_TYPE_ADDRESSING_MODEL,
+                                        text, 9, &entry));
+    EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+              spvOperandTableNameLookup(t, SPV_OPERAND_TYPE_ADDRESSING_MODEL,
+                                        text, 8, &entry));
+    EXPECT_EQ(SPV_SUCCESS,
+              spvOperandTableNameLookup(t, SPV_OPERAND_TYPE_ADDRESSING_MODEL,
+                                        text, 7, &entry));
+  }
+}
+
+TEST(OperandTableLookup, NameIsQualifiedByType) {
+  spv_operand_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOperandTableGet(&table));
+  spv_operand_desc entry = nullptr;
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOperandTableNameLookup(table, SPV_OPERAND_TYPE_MEMORY_MODEL,
+                                      "Logical", 7, &entry));
+}
+
+TEST(OperandTableLookup, UnknownValueIsRejected) {
+  spv_operand_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOperandTableGet(&table));
+  spv_operand_desc entry = nullptr;
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOperandTableValueLookup(table, SPV_OPERAND_TYPE_STORAGE_CLASS,
+                                       1000, &entry));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOperandTableValueLookup(table, SPV_OPERAND_TYPE_LOOP_CONTROL,
+                                       1u << 20, &entry));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            spvOperandTableValueLookup(table, SPV_OPERAND_TYPE_ID, 0, &entry));
+}
+
 }  // anonymous namespace
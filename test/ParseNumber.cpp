@@ -0,0 +1,326 @@
+// Copyright (c) 2016 The Khronos Group Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and/or associated documentation files (the
+// "Materials"), to deal in the Materials without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Materials, and to
+// permit persons to whom the Materials are furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Materials.
+//
+// MODIFICATIONS TO THIS FILE MAY MEAN IT NO LONGER ACCURATELY REFLECTS
+// KHRONOS STANDARDS. THE UNMODIFIED, NORMATIVE VERSIONS OF KHRONOS
+// SPECIFICATIONS AND HEADER INFORMATION ARE LOCATED AT
+//    https://www.khronos.org/registry/
+//
+// THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "UnitSPIRV.h"
+#include "util/parse_number.h"
+
+namespace {
+
+using spvutils::Float16;
+using spvutils::FloatProxy;
+using spvutils::HexFloat;
+
+// Parses text the way the assembler used to: with a std::istringstream, and
+// rejecting negative numbers other than zero for unsigned types, which GNU
+// libstdc++ would otherwise wrap around.
+template <typename T>
+bool ParseWithStream(const std::string& text, T* value) {
+  std::istringstream stream(text);
+  stream >> std::setbase(0);
+  stream >> *value;
+  bool ok = !text.empty() && !stream.bad() && stream.eof() && !stream.fail();
+  if (ok && std::is_unsigned<T>::value && text.find('-') != std::string::npos)
+    ok = *value == 0;
+  return ok;
+}
+
+// Checks that ParseInteger and ParseWithStream agree on text for type T.
+template <typename T>
+void ExpectSameAsStream(const std::string& text) {
+  T expected = 0;
+  T actual = 0;
+  const bool expected_ok = ParseWithStream(text, &expected);
+  ASSERT_EQ(expected_ok, spvutils::ParseInteger(text.data(), text.size(),
+                                                &actual))
+      << "'" << text << "' as " << sizeof(T) * 8 << "-bit "
+      << (std::is_signed<T>::value ? "signed" : "unsigned");
+  if (expected_ok) {
+    EXPECT_EQ(expected, actual) << "'" << text << "'";
+  }
+}
+
+void ExpectSameAsStreamForAllTypes(const std::string& text) {
+  ExpectSameAsStream<int16_t>(text);
+  ExpectSameAsStream<uint16_t>(text);
+  ExpectSameAsStream<int32_t>(text);
+  ExpectSameAsStream<uint32_t>(text);
+  ExpectSameAsStream<int64_t>(text);
+  ExpectSameAsStream<uint64_t>(text);
+}
+
+TEST(ParseInteger, ShortStringsMatchStream) {
+  // Every string of up to four characters drawn from those which matter to
+  // the parser.
+  const std::string alphabet = "0179afxX-+ g";
+  std::vector<std::string> texts = {""};
+  std::vector<std::string> shorter = {""};
+  for (int length = 1; length <= 4; ++length) {
+    std::vector<std::string> longer;
+    for (const auto& prefix : shorter)
+      for (char ch : alphabet) longer.push_back(prefix + ch);
+    texts.insert(texts.end(), longer.begin(), longer.end());
+    shorter.swap(longer);
+  }
+  for (const auto& text : texts) ExpectSameAsStreamForAllTypes(text);
+}
+
+TEST(ParseInteger, LimitsMatchStream) {
+  const char* texts[] = {
+      "32767", "32768", "-32768", "-32769", "65535", "65536", "-65535",
+      "2147483647", "2147483648", "-2147483648", "-2147483649", "4294967295",
+      "4294967296", "9223372036854775807", "9223372036854775808",
+      "-9223372036854775808", "-9223372036854775809", "18446744073709551615",
+      "18446744073709551616", "-18446744073709551615", "99999999999999999999",
+      "0x7fff", "0x8000", "0xffff", "0x10000", "-0x8000", "-0x8001",
+      "0x7fffffff", "0x80000000", "0xFFFFFFFF", "0x100000000",
+      "0x7fffffffffffffff", "0x8000000000000000", "0xffffffffffffffff",
+      "0x10000000000000000", "-0x8000000000000000", "-0x8000000000000001",
+      "0177777", "0200000", "01777777777777777777777",
+      "02000000000000000000000", "00000000000000000000000000000000001",
+      "0x000000000000000000000000000000001", "\t\n+0x1f"};
+  for (const char* text : texts) ExpectSameAsStreamForAllTypes(text);
+}
+
+TEST(ParseInteger, UsesOnlyTheGivenLength) {
+  int32_t value = 0;
+  EXPECT_TRUE(spvutils::ParseInteger("1234", 2, &value));
+  EXPECT_EQ(12, value);
+  EXPECT_FALSE(spvutils::ParseInteger("0x12", 2, &value));
+}
+
+TEST(ParseInteger, NegativeNumbersAreOutOfRangeForUnsignedTypes) {
+  uint32_t value = 1;
+  EXPECT_TRUE(spvutils::ParseInteger("-0", 2, &value));
+  EXPECT_EQ(0u, value);
+  EXPECT_FALSE(spvutils::ParseInteger(" -1", 3, &value));
+  EXPECT_EQ(0u, value);
+}
+
+// Parses text as a float of type T with ParseFloat, and the way the assembler
+// used to: by extracting a HexFloat from a std::istringstream.  Checks that
+// they agree.
+template <typename T>
+void ExpectFloatSameAsStream(const std::string& text) {
+  HexFloat<FloatProxy<T>> expected(T(0));
+  HexFloat<FloatProxy<T>> actual(T(0));
+  std::istringstream stream(text);
+  stream >> std::setbase(0);
+  stream >> expected;
+  const bool expected_ok =
+      !text.empty() && !stream.bad() && stream.eof() && !stream.fail();
+  ASSERT_EQ(expected_ok, spvutils::ParseFloat(text.data(), text.size(),
+                                              &actual))
+      << "'" << text << "' as " << sizeof(T) * 8 << "-bit float";
+  if (expected_ok) {
+    EXPECT_EQ(expected.value().data(), actual.value().data())
+        << "'" << text << "' as " << sizeof(T) * 8 << "-bit float";
+  }
+}
+
+void ExpectFloatSameAsStreamForAllTypes(const std::string& text) {
+  ExpectFloatSameAsStream<float>(text);
+  ExpectFloatSameAsStream<double>(text);
+}
+
+// Returns a random string of up to 20 decimal digits with an optional sign,
+// point and exponent.
+std::string RandomDecimal(std::mt19937* random) {
+  std::string text = (*random)() % 4 ? "" : "-";
+  const int digits = int((*random)() % 20) + 1;
+  const int point = int((*random)() % (digits + 2)) - 1;
+  for (int i = 0; i < digits; ++i) {
+    if (i == point) text += '.';
+    text += char('0' + (*random)() % 10);
+  }
+  if ((*random)() % 2) {
+    text += (*random)() % 2 ? "e" : "E-";
+    text += std::to_string((*random)() % 350);
+  }
+  return text;
+}
+
+// Returns a random hex float with the given number of hex digits in total,
+// and an optional sign and point.
+std::string RandomHexFloat(std::mt19937* random, int digits) {
+  std::string text = (*random)() % 4 ? "0x" : "-0X";
+  const int point = int((*random)() % (digits + 2)) - 1;
+  for (int i = 0; i < digits; ++i) {
+    if (i == point) text += '.';
+    text += "0123456789abcdefABCDEF"[(*random)() % 22];
+  }
+  text += (*random)() % 2 ? "p" : "p-";
+  text += std::to_string((*random)() % 1100);
+  return text;
+}
+
+TEST(ParseFloat, PrintedFloatsMatchStream) {
+  std::mt19937 random(1);
+  char text[64];
+  for (int i = 0; i < 20000; ++i) {
+    const uint64_t bits = (uint64_t(random()) << 32) | random();
+    double d;
+    std::memcpy(&d, &bits, sizeof(d));
+    if (std::isfinite(d)) {
+      std::snprintf(text, sizeof(text), "%.*g", int(random() % 17) + 1, d);
+      ExpectFloatSameAsStreamForAllTypes(text);
+    }
+    float f;
+    const uint32_t low_bits = uint32_t(bits);
+    std::memcpy(&f, &low_bits, sizeof(f));
+    if (std::isfinite(f)) {
+      std::snprintf(text, sizeof(text), "%.*g", int(random() % 9) + 1, f);
+      ExpectFloatSameAsStreamForAllTypes(text);
+    }
+  }
+}
+
+TEST(ParseFloat, RandomDecimalsMatchStream) {
+  std::mt19937 random(2);
+  for (int i = 0; i < 20000; ++i)
+    ExpectFloatSameAsStreamForAllTypes(RandomDecimal(&random));
+}
+
+TEST(ParseFloat, HalfwayCasesMatchStream) {
+  // Odd integers with just one more bit than a float or double can hold,
+  // shifted left, which are exactly halfway between two of them.
+  std::mt19937 random(3);
+  for (int i = 0; i < 20000; ++i) {
+    const int bits = int(random() % 2) ? 25 : 54;
+    const uint64_t odd = ((uint64_t(random()) << 32) | random() |
+                          uint64_t(1) << 63) >> (64 - bits) | 1;
+    const uint64_t value = odd << (random() % (64 - bits));
+    ExpectFloatSameAsStreamForAllTypes(std::to_string(value));
+  }
+}
+
+TEST(ParseFloat, HexFloatsMatchStream) {
+  std::mt19937 random(4);
+  for (int i = 0; i < 20000; ++i)
+    ExpectFloatSameAsStreamForAllTypes(RandomHexFloat(&random, random() % 40));
+}
+
+TEST(ParseFloat, ShortStringsMatchStream) {
+  const std::string alphabet = "019.eE+-xXp ";
+  std::vector<std::string> shorter = {""};
+  for (int length = 1; length <= 4; ++length) {
+    std::vector<std::string> longer;
+    for (const auto& prefix : shorter)
+      for (char ch : alphabet) longer.push_back(prefix + ch);
+    for (const auto& text : longer) ExpectFloatSameAsStreamForAllTypes(text);
+    shorter.swap(longer);
+  }
+}
+
+// Returns the bits of the 16-bit float parsed from text, or 0xdead if it
+// can't be parsed.
+uint32_t ParseFloat16(const std::string& text) {
+  HexFloat<FloatProxy<Float16>> value(uint16_t(0));
+  if (!spvutils::ParseFloat(text.data(), text.size(), &value)) return 0xdead;
+  return value.value().data();
+}
+
+TEST(ParseFloat, LongHexSignificandsMatchStream) {
+  // Both the stream and ParseFloat drop the significand bits which don't fit.
+  for (const std::string text :
+       {"0x1.ffffffffffffffffffp0", "0x123456789abcdef0123p0",
+        "-0x0.000000000000000001fffffffffffffffp0",
+        "0x1fffffffffffffffffffffffffffffffffffffff.8p-100"})
+    ExpectFloatSameAsStreamForAllTypes(text);
+  HexFloat<FloatProxy<float>> f(0.0f);
+  ASSERT_TRUE(spvutils::ParseFloat("0x1.ffffffffffffffffffp0", 24, &f));
+  EXPECT_EQ(0x3fffffffu, f.value().data());
+  HexFloat<FloatProxy<double>> d(0.0);
+  ASSERT_TRUE(spvutils::ParseFloat("0x123456789abcdef0123p0", 23, &d));
+  EXPECT_EQ(0x44723456789abcdeu, d.value().data());
+  EXPECT_EQ(0x3fffu, ParseFloat16("0x1.ffffffffffffffffffp0"));
+}
+
+TEST(ParseFloat, Float16RoundTrips) {
+  // Every finite 16-bit float, printed with enough digits to tell it apart
+  // from its neighbours, and exactly.
+  char text[64];
+  for (uint32_t bits = 0; bits < 0x10000; ++bits) {
+    if ((bits & 0x7c00) == 0x7c00) continue;
+    const uint32_t magnitude = bits & 0x7fff;
+    const double value =
+        magnitude < 0x400
+            ? std::ldexp(double(magnitude), -24)
+            : std::ldexp(double(0x400 | (magnitude & 0x3ff)),
+                         int(magnitude >> 10) - 25);
+    const double signed_value = bits & 0x8000 ? -value : value;
+    std::snprintf(text, sizeof(text), "%.5g", signed_value);
+    EXPECT_EQ(bits, ParseFloat16(text)) << text;
+    std::snprintf(text, sizeof(text), "%.17g", signed_value);
+    EXPECT_EQ(bits, ParseFloat16(text)) << text;
+  }
+}
+
+TEST(ParseFloat, Float16Rounding) {
+  // Ties go to even.
+  EXPECT_EQ(0x6800u, ParseFloat16("2049"));
+  EXPECT_EQ(0x6802u, ParseFloat16("2051"));
+  EXPECT_EQ(0x3c00u, ParseFloat16("1.00048828125"));
+  EXPECT_EQ(0x3c01u, ParseFloat16("1.0004882812500001"));
+  // Subnormals, and values too small for them.
+  EXPECT_EQ(0x0001u, ParseFloat16("5.9604644775390625e-8"));
+  EXPECT_EQ(0x0000u, ParseFloat16("2.98023223876953125e-8"));
+  EXPECT_EQ(0x0001u, ParseFloat16("2.99e-8"));
+  EXPECT_EQ(0x8000u, ParseFloat16("-1e-30"));
+  // Decimals too long for an exact double, which the double puts exactly
+  // halfway between two 16-bit floats.  This one is just above 2^-25.
+  EXPECT_EQ(0x0001u,
+            ParseFloat16("0.000000029802322387695313327180612553027674871408"
+                         "6920699628535658121109008789062"));
+  EXPECT_EQ(0x0000u, ParseFloat16("2.98023223876953124999999999999e-8"));
+  EXPECT_EQ(0x0000u, ParseFloat16("2.98023223876953125000000000000e-8"));
+  EXPECT_EQ(0x6801u, ParseFloat16("2049.00000000000000000001"));
+  EXPECT_EQ(0xe800u, ParseFloat16("-2048.99999999999999999999"));
+  EXPECT_EQ(0x6800u, ParseFloat16("20.49000000000000000000e2"));
+  EXPECT_EQ(0x7bffu, ParseFloat16("65519.9999999999999999999"));
+  EXPECT_EQ(0xdeadu, ParseFloat16("65520.0000000000000000001"));
+  // The largest value, and those which would round to infinity.
+  EXPECT_EQ(0x7bffu, ParseFloat16("65519.99"));
+  EXPECT_EQ(0xdeadu, ParseFloat16("65520"));
+  EXPECT_EQ(0xdeadu, ParseFloat16("-1e10"));
+  // Hex floats are truncated, as for the other widths.
+  EXPECT_EQ(0x0001u, ParseFloat16("0x1p-24"));
+  EXPECT_EQ(0x3fffu, ParseFloat16("0x1.fffp0"));
+  EXPECT_EQ(0x7c00u, ParseFloat16("0x1p16"));
+  EXPECT_EQ(0xdeadu, ParseFloat16("1.5f"));
+}
+
+}  // anonymous namespace
@@ -76,6 +76,36 @@ TEST(TextAdvance, LeadingWhitespaceAfterCommentLine) {
   ASSERT_EQ(14u, data.position().index);
 }
 
+TEST(TextAdvance, LongRunsOfWhitespaceAndComments) {
+  // Long enough to be skipped in several blocks at a time.
+  const std::string blanks(37, ' ');
+  AutoText input(blanks + "\t\n; " + std::string(50, '-') + "\n" + blanks +
+                 ";\n\t" + blanks + "Word");
+  AssemblyContext data(input, nullptr);
+  ASSERT_EQ(SPV_SUCCESS, data.advance());
+  EXPECT_EQ(38u, data.position().column);
+  EXPECT_EQ(3u, data.position().line);
+  EXPECT_EQ(input.str.find("Word"), data.position().index);
+}
+
+TEST(TextAdvance, EOFAfterLongComment) {
+  AutoText input("; " + std::string(40, 'x'));
+  AssemblyContext data(input, nullptr);
+  ASSERT_EQ(SPV_END_OF_STREAM, data.advance());
+  EXPECT_EQ(42u, data.position().column);
+  EXPECT_EQ(42u, data.position().index);
+}
+
+TEST(TextAdvance, NullTerminatorInLongComment) {
+  const char text[] = "; comment\0 which goes on past the null terminator\n";
+  spv_text_t input = {text, sizeof(text) - 1};
+  AssemblyContext data(&input, nullptr);
+  ASSERT_EQ(SPV_END_OF_STREAM, data.advance());
+  EXPECT_EQ(9u, data.position().column);
+  EXPECT_EQ(0u, data.position().line);
+  EXPECT_EQ(9u, data.position().index);
+}
+
 TEST(TextAdvance, EOFAfterCommentLine) {
   AutoText input("; comment");
   AssemblyContext data(input, nullptr);
@@ -41,19 +41,22 @@ TEST(TextStartsWithOp, YesAtStart) {
 
 TEST(TextStartsWithOp, YesAtMiddle) {
   {
-    AssemblyContext dat(AutoText("  OpFoo"), nullptr);
+    AutoText input("  OpFoo");
+    AssemblyContext dat(input, nullptr);
     dat.seekForward(2);
     EXPECT_TRUE(dat.isStartOfNewInst());
   }
   {
-    AssemblyContext dat(AutoText("xx OpFoo"), nullptr);
+    AutoText input("xx OpFoo");
+    AssemblyContext dat(input, nullptr);
     dat.seekForward(2);
     EXPECT_TRUE(dat.isStartOfNewInst());
   }
 }
 
 TEST(TextStartsWithOp, NoIfTooFar) {
-  AssemblyContext dat(AutoText("  OpFoo"), nullptr);
+  AutoText input("  OpFoo");
+  AssemblyContext dat(input, nullptr);
   dat.seekForward(3);
   EXPECT_FALSE(dat.isStartOfNewInst());
 }
@@ -139,6 +139,18 @@ INSTANTIATE_TEST_CASE_P(
       {"OpTypeInt 16 1", "-32",
         Concatenate({MakeInstruction(SpvOpTypeInt, {1, 16, 1}),
          MakeInstruction(SpvOpConstant, {1, 2, uint32_t(-32)})})},
+      {"OpTypeFloat 16", "1.5",
+        Concatenate({MakeInstruction(SpvOpTypeFloat, {1, 16}),
+         MakeInstruction(SpvOpConstant, {1, 2, 0x3e00})})},
+      {"OpTypeFloat 16", "-0.1",
+        Concatenate({MakeInstruction(SpvOpTypeFloat, {1, 16}),
+         MakeInstruction(SpvOpConstant, {1, 2, 0xae66})})},
+      {"OpTypeFloat 16", "0x1.ffcp+15", // Largest finite value.
+        Concatenate({MakeInstruction(SpvOpTypeFloat, {1, 16}),
+         MakeInstruction(SpvOpConstant, {1, 2, 0x7bff})})},
+      {"OpTypeFloat 16", "-0x1p+16", // -infinity
+        Concatenate({MakeInstruction(SpvOpTypeFloat, {1, 16}),
+         MakeInstruction(SpvOpConstant, {1, 2, 0xfc00})})},
       // Check 32 bits
       {"OpTypeInt 32 0", "42",
         Concatenate({MakeInstruction(SpvOpTypeInt, {1, 32, 0}),
@@ -27,10 +27,14 @@
 // Assembler tests for literal numbers and literal strings.
 
 #include "TestFixture.h"
+#include "gmock/gmock.h"
 
 namespace {
 
+using spvtest::MakeInstruction;
+using spvtest::MakeVector;
 using spvtest::TextToBinaryTest;
+using ::testing::Eq;
 
 TEST_F(TextToBinaryTest, LiteralStringInPlaceOfLiteralNumber) {
   EXPECT_EQ(
@@ -130,4 +134,10 @@ TEST_F(TextToBinaryTest, LiteralStringUTF8LongEncodings) {
             CompileFailure("OpName %target \"" + bad_1_arg_string + "\"\n"));
 }
 
+TEST_F(TextToBinaryTest, LiteralStringWithEscapes) {
+  EXPECT_THAT(CompiledInstructions(R"(OpSourceExtension "a\"b\\c\d")"),
+              Eq(MakeInstruction(SpvOpSourceExtension,
+                                 MakeVector("a\"b\\cd"))));
+}
+
 }  // anonymous namespace
@@ -61,6 +61,15 @@ TEST(GetWord, Simple) {
   EXPECT_EQ("abc", AssemblyContext(AutoText("abc\n"), nullptr).getWord());
 }
 
+TEST(GetWord, StopsAtEndOfText) {
+  // The text need not be null-terminated.
+  spv_text_t text = {"abcdef", 3};
+  EXPECT_EQ("abc", AssemblyContext(&text, nullptr).getWord());
+  spv_text_t long_text = {"abcdefghijklmnopqrstuvwxyz", 20};
+  EXPECT_EQ("abcdefghijklmnopqrst",
+            AssemblyContext(&long_text, nullptr).getWord());
+}
+
 // An mask parsing test case.
 struct MaskCase {
   spv_operand_type_t which_enum;
@@ -133,6 +142,35 @@ INSTANTIATE_TEST_CASE_P(ParseMask, BadFPFastMathMaskParseTest,
                             "Unroll"  // A good word, but for the wrong enum
                         }));
 
+TEST(AssemblyGrammarLookup, NamesWithEmbeddedNullAreRejected) {
+  spv_context context = spvContextCreate();
+  AssemblyGrammar grammar(context);
+
+  SpvOp opcode;
+  const char spec_op[] = "IAdd\0\0";
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            grammar.lookupSpecConstantOpcode(spec_op, 6, &opcode));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            grammar.lookupSpecConstantOpcode(spec_op, 5, &opcode));
+  EXPECT_EQ(SPV_SUCCESS, grammar.lookupSpecConstantOpcode(spec_op, 4, &opcode));
+  EXPECT_EQ(SpvOpIAdd, opcode);
+
+  spv_ext_inst_desc ext_inst = nullptr;
+  const char ext_name[] = "Sqrt\0\0";
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            grammar.lookupExtInst(SPV_EXT_INST_TYPE_GLSL_STD_450, ext_name, 6,
+                                  &ext_inst));
+  EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+            grammar.lookupExtInst(SPV_EXT_INST_TYPE_GLSL_STD_450, ext_name, 5,
+                                  &ext_inst));
+  EXPECT_EQ(SPV_SUCCESS,
+            grammar.lookupExtInst(SPV_EXT_INST_TYPE_GLSL_STD_450, ext_name, 4,
+                                  &ext_inst));
+  EXPECT_STREQ("Sqrt", ext_inst->name);
+
+  spvContextDestroy(context);
+}
+
 // TODO(dneto): Aliasing like this relies on undefined behaviour. Fix this.
 union char_word_t {
   char cs[4];
@@ -163,6 +201,69 @@ TEST_F(TextToBinaryTest, InvalidDiagnostic) {
             spvTextToBinary(context, text.str, text.length, &binary, nullptr));
 }
 
+TEST_F(TextToBinaryTest, BufferMatchesBinary) {
+  SetText("%1 = OpTypeVoid\n%2 = OpTypeFunction %1\nOpName %2 \"main\"\n");
+  spv_binary binary;
+  ASSERT_EQ(SPV_SUCCESS, spvTextToBinary(context, text.str, text.length,
+                                         &binary, &diagnostic));
+  const std::vector<uint32_t> expected(binary->code,
+                                       binary->code + binary->wordCount);
+  spvBinaryDestroy(binary);
+
+  // Asking with no buffer reports the size needed.
+  size_t word_count = 0;
+  ASSERT_EQ(SPV_ERROR_BUFFER_TOO_SMALL,
+            spvTextToBinaryBuffer(context, text.str, text.length, nullptr, 0,
+                                  &word_count, &diagnostic));
+  EXPECT_EQ(expected.size(), word_count);
+  EXPECT_EQ(nullptr, diagnostic);
+
+  // One word too few is still too small.
+  std::vector<uint32_t> words(expected.size() - 1);
+  ASSERT_EQ(SPV_ERROR_BUFFER_TOO_SMALL,
+            spvTextToBinaryBuffer(context, text.str, text.length, words.data(),
+                                  words.size(), &word_count, &diagnostic));
+  EXPECT_EQ(expected.size(), word_count);
+
+  // A larger buffer can be reused for the same module.
+  words.assign(expected.size() + 10, 0xdeadbeef);
+  for (int i = 0; i < 2; ++i) {
+    word_count = 0;
+    ASSERT_EQ(SPV_SUCCESS, spvTextToBinaryBuffer(
+                               context, text.str, text.length, words.data(),
+                               words.size(), &word_count, &diagnostic));
+    ASSERT_EQ(expected.size(), word_count);
+    EXPECT_THAT(std::vector<uint32_t>(words.begin(),
+                                      words.begin() + word_count),
+                Eq(expected));
+  }
+}
+
+TEST_F(TextToBinaryTest, BufferInvalidText) {
+  SetText("%1 = OpTypeVoid\nOpNotAnOpcode\n");
+  size_t word_count = 0;
+  ASSERT_EQ(SPV_ERROR_INVALID_TEXT,
+            spvTextToBinaryBuffer(context, text.str, text.length, nullptr, 0,
+                                  &word_count, &diagnostic));
+  ASSERT_NE(nullptr, diagnostic);
+  EXPECT_TRUE(diagnostic->isTextSource);
+}
+
+TEST_F(TextToBinaryTest, BufferInvalidPointer) {
+  SetText("OpMemoryModel Logical GLSL450\n");
+  uint32_t words[16];
+  size_t word_count = 0;
+  EXPECT_EQ(SPV_ERROR_INVALID_POINTER,
+            spvTextToBinaryBuffer(context, text.str, text.length, words, 16,
+                                  nullptr, &diagnostic));
+  EXPECT_EQ(SPV_ERROR_INVALID_POINTER,
+            spvTextToBinaryBuffer(context, text.str, text.length, nullptr, 16,
+                                  &word_count, &diagnostic));
+  EXPECT_EQ(SPV_ERROR_INVALID_DIAGNOSTIC,
+            spvTextToBinaryBuffer(context, text.str, text.length, words, 16,
+                                  &word_count, nullptr));
+}
+
 TEST_F(TextToBinaryTest, InvalidPrefix) {
   EXPECT_EQ(
       "Expected <opcode> or <result-id> at the beginning of an instruction, "
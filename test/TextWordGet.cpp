@@ -37,47 +37,51 @@ using spvtest::AutoText;
 #define QUOTE R"(")"
 
 TEST(TextWordGet, NullTerminator) {
-  std::string word;
+  AutoText input("Word");
+  libspirv::TextToken word;
   spv_position_t endPosition = {};
-  ASSERT_EQ(SPV_SUCCESS, AssemblyContext(AutoText("Word"), nullptr)
-                             .getWord(word, &endPosition));
+  ASSERT_EQ(SPV_SUCCESS,
+            AssemblyContext(input, nullptr).getWord(word, &endPosition));
   ASSERT_EQ(4u, endPosition.column);
   ASSERT_EQ(0u, endPosition.line);
   ASSERT_EQ(4u, endPosition.index);
-  ASSERT_STREQ("Word", word.c_str());
+  ASSERT_STREQ("Word", word.str().c_str());
 }
 
 TEST(TextWordGet, TabTerminator) {
-  std::string word;
+  AutoText input("Word\t");
+  libspirv::TextToken word;
   spv_position_t endPosition = {};
-  ASSERT_EQ(SPV_SUCCESS, AssemblyContext(AutoText("Word\t"), nullptr)
-                             .getWord(word, &endPosition));
+  ASSERT_EQ(SPV_SUCCESS,
+            AssemblyContext(input, nullptr).getWord(word, &endPosition));
   ASSERT_EQ(4u, endPosition.column);
   ASSERT_EQ(0u, endPosition.line);
   ASSERT_EQ(4u, endPosition.index);
-  ASSERT_STREQ("Word", word.c_str());
+  ASSERT_STREQ("Word", word.str().c_str());
 }
 
 TEST(TextWordGet, SpaceTerminator) {
-  std::string word;
+  AutoText input("Word ");
+  libspirv::TextToken word;
   spv_position_t endPosition = {};
-  ASSERT_EQ(SPV_SUCCESS, AssemblyContext(AutoText("Word "), nullptr)
-                             .getWord(word, &endPosition));
+  ASSERT_EQ(SPV_SUCCESS,
+            AssemblyContext(input, nullptr).getWord(word, &endPosition));
   ASSERT_EQ(4u, endPosition.column);
   ASSERT_EQ(0u, endPosition.line);
   ASSERT_EQ(4u, endPosition.index);
-  ASSERT_STREQ("Word", word.c_str());
+  ASSERT_STREQ("Word", word.str().c_str());
 }
 
 TEST(TextWordGet, SemicolonTerminator) {
-  std::string word;
+  AutoText input("Wo;rd");
+  libspirv::TextToken word;
   spv_position_t endPosition = {};
-  ASSERT_EQ(SPV_SUCCESS, AssemblyContext(AutoText("Wo;rd"), nullptr)
-                             .getWord(word, &endPosition));
+  ASSERT_EQ(SPV_SUCCESS,
+            AssemblyContext(input, nullptr).getWord(word, &endPosition));
   ASSERT_EQ(2u, endPosition.column);
   ASSERT_EQ(0u, endPosition.line);
   ASSERT_EQ(2u, endPosition.index);
-  ASSERT_STREQ("Wo", word.c_str());
+  ASSERT_STREQ("Wo", word.str().c_str());
 }
 
 TEST(TextWordGet, MultipleWords) {
@@ -87,7 +91,7 @@ TEST(TextWordGet, MultipleWords) {
   spv_position_t endPosition = {};
   const char* words[] = {"Words", "in", "a", "sentence"};
 
-  std::string word;
+  libspirv::TextToken word;
   for (uint32_t wordIndex = 0; wordIndex < 4; ++wordIndex) {
     ASSERT_EQ(SPV_SUCCESS, data.getWord(word, &endPosition));
     ASSERT_EQ(strlen(words[wordIndex]),
@@ -95,7 +99,7 @@ TEST(TextWordGet, MultipleWords) {
     ASSERT_EQ(0u, endPosition.line);
     ASSERT_EQ(strlen(words[wordIndex]),
               endPosition.index - data.position().index);
-    ASSERT_STREQ(words[wordIndex], word.c_str());
+    ASSERT_STREQ(words[wordIndex], word.str().c_str());
 
     data.setPosition(endPosition);
     if (3 != wordIndex) {
@@ -111,13 +115,13 @@ TEST(TextWordGet, QuotesAreKept) {
   const char* expected[] = {R"("quotes")", R"("around words")"};
   AssemblyContext data(input, nullptr);
 
-  std::string word;
+  libspirv::TextToken word;
   spv_position_t endPosition = {};
   ASSERT_EQ(SPV_SUCCESS, data.getWord(word, &endPosition));
   EXPECT_EQ(8u, endPosition.column);
   EXPECT_EQ(0u, endPosition.line);
   EXPECT_EQ(8u, endPosition.index);
-  EXPECT_STREQ(expected[0], word.c_str());
+  EXPECT_STREQ(expected[0], word.str().c_str());
 
   // Move to the next word.
   data.setPosition(endPosition);
@@ -127,7 +131,7 @@ TEST(TextWordGet, QuotesAreKept) {
   EXPECT_EQ(23u, endPosition.column);
   EXPECT_EQ(0u, endPosition.line);
   EXPECT_EQ(23u, endPosition.index);
-  EXPECT_STREQ(expected[1], word.c_str());
+  EXPECT_STREQ(expected[1], word.str().c_str());
 }
 
 TEST(TextWordGet, QuotesBetweenWordsActLikeGlue) {
@@ -135,13 +139,13 @@ TEST(TextWordGet, QuotesBetweenWordsActLikeGlue) {
   const char* expected[] = {R"(quotes" "between)", "words"};
   AssemblyContext data(input, nullptr);
 
-  std::string word;
+  libspirv::TextToken word;
   spv_position_t endPosition = {};
   ASSERT_EQ(SPV_SUCCESS, data.getWord(word, &endPosition));
   EXPECT_EQ(16u, endPosition.column);
   EXPECT_EQ(0u, endPosition.line);
   EXPECT_EQ(16u, endPosition.index);
-  EXPECT_STREQ(expected[0], word.c_str());
+  EXPECT_STREQ(expected[0], word.str().c_str());
 
   // Move to the next word.
   data.setPosition(endPosition);
@@ -151,13 +155,13 @@ TEST(TextWordGet, QuotesBetweenWordsActLikeGlue) {
   EXPECT_EQ(22u, endPosition.column);
   EXPECT_EQ(0u, endPosition.line);
   EXPECT_EQ(22u, endPosition.index);
-  EXPECT_STREQ(expected[1], word.c_str());
+  EXPECT_STREQ(expected[1], word.str().c_str());
 }
 
 TEST(TextWordGet, QuotingWhitespace) {
   AutoText input(QUOTE "white " NEWLINE TAB " space" QUOTE);
   // Whitespace surrounded by quotes acts like glue.
-  std::string word;
+  libspirv::TextToken word;
   spv_position_t endPosition = {};
   ASSERT_EQ(SPV_SUCCESS,
             AssemblyContext(input, nullptr).getWord(word, &endPosition));
@@ -169,43 +173,43 @@ TEST(TextWordGet, QuotingWhitespace) {
 
 TEST(TextWordGet, QuoteAlone) {
   AutoText input(QUOTE);
-  std::string word;
+  libspirv::TextToken word;
   spv_position_t endPosition = {};
   ASSERT_EQ(SPV_SUCCESS,
             AssemblyContext(input, nullptr).getWord(word, &endPosition));
   ASSERT_EQ(1u, endPosition.column);
   ASSERT_EQ(0u, endPosition.line);
   ASSERT_EQ(1u, endPosition.index);
-  ASSERT_STREQ(QUOTE, word.c_str());
+  ASSERT_STREQ(QUOTE, word.str().c_str());
 }
 
 TEST(TextWordGet, EscapeAlone) {
   AutoText input(BACKSLASH);
-  std::string word;
+  libspirv::TextToken word;
   spv_position_t endPosition = {};
   ASSERT_EQ(SPV_SUCCESS,
             AssemblyContext(input, nullptr).getWord(word, &endPosition));
   ASSERT_EQ(1u, endPosition.column);
   ASSERT_EQ(0u, endPosition.line);
   ASSERT_EQ(1u, endPosition.index);
-  ASSERT_STREQ(BACKSLASH, word.c_str());
+  ASSERT_STREQ(BACKSLASH, word.str().c_str());
 }
 
 TEST(TextWordGet, EscapeAtEndOfInput) {
   AutoText input("word" BACKSLASH);
-  std::string word;
+  libspirv::TextToken word;
   spv_position_t endPosition = {};
   ASSERT_EQ(SPV_SUCCESS,
             AssemblyContext(input, nullptr).getWord(word, &endPosition));
   ASSERT_EQ(5u, endPosition.column);
   ASSERT_EQ(0u, endPosition.line);
   ASSERT_EQ(5u, endPosition.index);
-  ASSERT_STREQ("word" BACKSLASH, word.c_str());
+  ASSERT_STREQ("word" BACKSLASH, word.str().c_str());
 }
 
 TEST(TextWordGet, Escaping) {
   AutoText input("w" BACKSLASH QUOTE "o" BACKSLASH NEWLINE "r" BACKSLASH ";d");
-  std::string word;
+  libspirv::TextToken word;
   spv_position_t endPosition = {};
   ASSERT_EQ(SPV_SUCCESS,
             AssemblyContext(input, nullptr).getWord(word, &endPosition));
@@ -217,14 +221,49 @@ TEST(TextWordGet, Escaping) {
 
 TEST(TextWordGet, EscapingEscape) {
   AutoText input("word" BACKSLASH BACKSLASH " abc");
-  std::string word;
+  libspirv::TextToken word;
   spv_position_t endPosition = {};
   ASSERT_EQ(SPV_SUCCESS,
             AssemblyContext(input, nullptr).getWord(word, &endPosition));
   ASSERT_EQ(6u, endPosition.column);
   ASSERT_EQ(0u, endPosition.line);
   ASSERT_EQ(6u, endPosition.index);
-  ASSERT_STREQ("word" BACKSLASH BACKSLASH, word.c_str());
+  ASSERT_STREQ("word" BACKSLASH BACKSLASH, word.str().c_str());
+}
+
+TEST(TextWordGet, LongWords) {
+  // Long enough to be scanned in several blocks at a time.
+  const std::string first = "%" + std::string(40, 'a');
+  const std::string second = "\"" + std::string(20, 'b') + " \\\" " +
+                             std::string(20, 'c') + "\"";
+  AutoText input(first + " " + second + ";comment");
+  AssemblyContext data(input, nullptr);
+
+  libspirv::TextToken word;
+  spv_position_t endPosition = {};
+  ASSERT_EQ(SPV_SUCCESS, data.getWord(word, &endPosition));
+  EXPECT_EQ(first.size(), endPosition.column);
+  EXPECT_EQ(first.size(), endPosition.index);
+  EXPECT_EQ(first, word);
+
+  data.setPosition(endPosition);
+  ASSERT_EQ(SPV_SUCCESS, data.advance());
+  ASSERT_EQ(SPV_SUCCESS, data.getWord(word, &endPosition));
+  EXPECT_EQ(first.size() + 1 + second.size(), endPosition.column);
+  EXPECT_EQ(0u, endPosition.line);
+  EXPECT_EQ(first.size() + 1 + second.size(), endPosition.index);
+  EXPECT_EQ(second, word);
+}
+
+TEST(TextWordGet, NoNullTerminator) {
+  spv_text_t input = {"OpNopSomething else in memory", 5};
+  libspirv::TextToken word;
+  spv_position_t endPosition = {};
+  ASSERT_EQ(SPV_SUCCESS,
+            AssemblyContext(&input, nullptr).getWord(word, &endPosition));
+  EXPECT_EQ(5u, endPosition.column);
+  EXPECT_EQ(5u, endPosition.index);
+  EXPECT_EQ("OpNop", word);
 }
 
 }  // anonymous namespace
@@ -0,0 +1,175 @@
+// Copyright (c) 2016 The Khronos Group Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and/or associated documentation files (the
+// "Materials"), to deal in the Materials without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Materials, and to
+// permit persons to whom the Materials are furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Materials.
+//
+// MODIFICATIONS TO THIS FILE MAY MEAN IT NO LONGER ACCURATELY REFLECTS
+// KHRONOS STANDARDS. THE UNMODIFIED, NORMATIVE VERSIONS OF KHRONOS
+// SPECIFICATIONS AND HEADER INFORMATION ARE LOCATED AT
+//    https://www.khronos.org/registry/
+//
+// THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+
+// Tests for validating several modules with spvValidateBatch
+
+#include "UnitSPIRV.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// A module which is valid.
+const char kValid[] = R"(
+     OpMemoryModel Logical GLSL450
+%1 = OpTypeVoid
+%2 = OpTypeFunction %1
+%3 = OpFunction %1 None %2
+%4 = OpLabel
+     OpReturn
+     OpFunctionEnd
+)";
+
+// A module which fails the layout checks.
+const char kNoMemoryModel[] = R"(
+%1 = OpTypeVoid
+%2 = OpTypeFunction %1
+)";
+
+// A module which fails the SSA checks in the middle of a function.
+const char kUndefinedId[] = R"(
+     OpMemoryModel Logical GLSL450
+%1 = OpTypeVoid
+%2 = OpTypeFunction %1
+%3 = OpFunction %1 None %2
+%4 = OpLabel
+     OpReturnValue %5
+     OpFunctionEnd
+)";
+
+// A module which fails the ID checks.
+const char kBadResultType[] = R"(
+     OpMemoryModel Logical GLSL450
+%1 = OpTypeVoid
+%2 = OpTypeFunction %1
+%5 = OpTypeInt 32 0
+%3 = OpFunction %5 None %2
+%4 = OpLabel
+     OpReturn
+     OpFunctionEnd
+)";
+
+class ValidateBatch : public ::testing::Test {
+ public:
+  ValidateBatch() : context_(spvContextCreate()) {}
+  ~ValidateBatch() {
+    for (auto binary : binaries_) spvBinaryDestroy(binary);
+    spvContextDestroy(context_);
+  }
+
+  // Assembles the text as the next module of the batch.
+  void Add(const char* text) {
+    spv_binary binary = nullptr;
+    spv_diagnostic diagnostic = nullptr;
+    ASSERT_EQ(SPV_SUCCESS, spvTextToBinary(context_, text, strlen(text),
+                                           &binary, &diagnostic));
+    binaries_.push_back(binary);
+  }
+
+  // Validates the modules on the given number of threads, and checks that
+  // the result and diagnostic of each one is the same as from spvValidate.
+  // Returns the result of the batch.
+  spv_result_t ValidateOnThreads(uint32_t threadCount) {
+    const size_t count = binaries_.size();
+    std::vector<spv_const_binary_t> const_binaries;
+    std::vector<spv_const_binary> const_binary_pointers;
+    const_binaries.reserve(count);
+    for (spv_binary binary : binaries_) {
+      const_binaries.push_back({binary->code, binary->wordCount});
+      const_binary_pointers.push_back(&const_binaries.back());
+    }
+    std::vector<spv_result_t> results(count, SPV_UNSUPPORTED);
+    std::vector<spv_diagnostic> diagnostics(count, nullptr);
+    const spv_result_t result = spvValidateBatch(
+        context_, const_binary_pointers.data(), count, SPV_VALIDATE_ALL,
+        threadCount, results.data(), diagnostics.data());
+    for (size_t i = 0; i < count; ++i) {
+      spv_diagnostic expected_diagnostic = nullptr;
+      EXPECT_EQ(spvValidate(context_, const_binary_pointers[i],
+                            SPV_VALIDATE_ALL, &expected_diagnostic),
+                results[i])
+          << "module " << i;
+      EXPECT_EQ(Message(expected_diagnostic), Message(diagnostics[i]))
+          << "module " << i;
+      spvDiagnosticDestroy(expected_diagnostic);
+      spvDiagnosticDestroy(diagnostics[i]);
+    }
+    return result;
+  }
+
+  // Returns the message of the diagnostic, or an empty string if there is
+  // none.
+  static std::string Message(spv_diagnostic diagnostic) {
+    return diagnostic ? diagnostic->error : "";
+  }
+
+  spv_context context_;
+  std::vector<spv_binary> binaries_;
+};
+
+TEST_F(ValidateBatch, EmptyBatchIsValid) {
+  EXPECT_EQ(SPV_SUCCESS, ValidateOnThreads(0));
+}
+
+TEST_F(ValidateBatch, ValidModules) {
+  for (int i = 0; i < 10; ++i) Add(kValid);
+  for (uint32_t threads : {0u, 1u, 3u, 16u}) {
+    EXPECT_EQ(SPV_SUCCESS, ValidateOnThreads(threads));
+  }
+}
+
+TEST_F(ValidateBatch, EachModuleGetsItsOwnResult) {
+  // Modules following an invalid one on the same thread reuse the state it
+  // left behind.
+  const char* const texts[] = {kValid, kUndefinedId, kValid, kBadResultType,
+                               kNoMemoryModel, kValid};
+  for (int repeat = 0; repeat < 20; ++repeat) {
+    for (const char* text : texts) Add(text);
+  }
+  for (uint32_t threads : {0u, 1u, 2u, 7u}) {
+    EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateOnThreads(threads));
+  }
+}
+
+TEST_F(ValidateBatch, ReturnsFirstFailureInArrayOrder) {
+  Add(kValid);
+  Add(kNoMemoryModel);
+  Add(kBadResultType);
+  EXPECT_EQ(SPV_ERROR_INVALID_LAYOUT, ValidateOnThreads(3));
+}
+
+TEST_F(ValidateBatch, NullDiagnosticsIsInvalid) {
+  Add(kValid);
+  spv_const_binary_t binary = {binaries_[0]->code, binaries_[0]->wordCount};
+  spv_const_binary binaries[] = {&binary};
+  spv_result_t result;
+  EXPECT_EQ(SPV_ERROR_INVALID_DIAGNOSTIC,
+            spvValidateBatch(context_, binaries, 1, SPV_VALIDATE_ALL, 1,
+                             &result, nullptr));
+}
+
+}  // anonymous namespace
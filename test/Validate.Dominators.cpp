@@ -0,0 +1,217 @@
+// Copyright (c) 2016 The Khronos Group Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and/or associated documentation files (the
+// "Materials"), to deal in the Materials without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Materials, and to
+// permit persons to whom the Materials are furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Materials.
+//
+// MODIFICATIONS TO THIS FILE MAY MEAN IT NO LONGER ACCURATELY REFLECTS
+// KHRONOS STANDARDS. THE UNMODIFIED, NORMATIVE VERSIONS OF KHRONOS
+// SPECIFICATIONS AND HEADER INFORMATION ARE LOCATED AT
+//    https://www.khronos.org/registry/
+//
+// THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+
+
+// Tests for the dominator tree used by the SSA validation pass
+
+#include "UnitSPIRV.h"
+#include "gmock/gmock.h"
+#include "source/validate_cfg.h"
+
+#include <cstdlib>
+#include <vector>
+
+using libspirv::DominatorTree;
+using std::vector;
+
+namespace {
+
+// A control flow graph under construction, with blocks numbered from 0.
+class Graph {
+ public:
+  explicit Graph(uint32_t num_blocks) : edges_(num_blocks) {}
+
+  Graph& edge(uint32_t from, uint32_t to) {
+    edges_[from].push_back(to);
+    return *this;
+  }
+
+  DominatorTree tree() const {
+    vector<uint32_t> offsets;
+    vector<uint32_t> successors;
+    for (const auto& block : edges_) {
+      offsets.push_back(static_cast<uint32_t>(successors.size()));
+      successors.insert(successors.end(), block.begin(), block.end());
+    }
+    offsets.push_back(static_cast<uint32_t>(successors.size()));
+    return DominatorTree(offsets, successors);
+  }
+
+  // Returns dom[a][b], which is true if a dominates b, computed by the
+  // iterative data flow algorithm.
+  vector<vector<bool>> naiveDominators() const {
+    const size_t n = edges_.size();
+    vector<bool> reachable(n, false);
+    vector<uint32_t> stack(1, 0);
+    reachable[0] = true;
+    while (!stack.empty()) {
+      const uint32_t b = stack.back();
+      stack.pop_back();
+      for (uint32_t s : edges_[b]) {
+        if (!reachable[s]) {
+          reachable[s] = true;
+          stack.push_back(s);
+        }
+      }
+    }
+    // doms[b][a] is true if a dominates b.
+    vector<vector<bool>> doms(n, reachable);
+    doms[0].assign(n, false);
+    doms[0][0] = true;
+    for (bool changed = true; changed;) {
+      changed = false;
+      for (uint32_t b = 1; b < n; ++b) {
+        if (!reachable[b]) continue;
+        vector<bool> meet = reachable;
+        for (uint32_t p = 0; p < n; ++p) {
+          if (!reachable[p]) continue;
+          for (uint32_t s : edges_[p]) {
+            if (s != b) continue;
+            for (uint32_t a = 0; a < n; ++a) meet[a] = meet[a] && doms[p][a];
+          }
+        }
+        meet[b] = true;
+        if (meet != doms[b]) {
+          doms[b] = meet;
+          changed = true;
+        }
+      }
+    }
+    vector<vector<bool>> dom(n, vector<bool>(n, false));
+    for (uint32_t b = 0; b < n; ++b) {
+      for (uint32_t a = 0; a < n; ++a) {
+        dom[a][b] = reachable[a] && reachable[b] && doms[b][a];
+      }
+    }
+    return dom;
+  }
+
+ private:
+  vector<vector<uint32_t>> edges_;
+};
+
+TEST(DominatorTree, Diamond) {
+  const DominatorTree tree =
+      Graph(4).edge(0, 1).edge(0, 2).edge(1, 3).edge(2, 3).tree();
+  EXPECT_EQ(0u, tree.immediateDominator(1));
+  EXPECT_EQ(0u, tree.immediateDominator(2));
+  EXPECT_EQ(0u, tree.immediateDominator(3));
+  EXPECT_TRUE(tree.dominates(0, 3));
+  EXPECT_TRUE(tree.dominates(3, 3));
+  EXPECT_FALSE(tree.dominates(1, 3));
+  EXPECT_FALSE(tree.dominates(1, 2));
+}
+
+TEST(DominatorTree, Loop) {
+  const DominatorTree tree =
+      Graph(4).edge(0, 1).edge(1, 2).edge(2, 1).edge(2, 3).tree();
+  EXPECT_EQ(1u, tree.immediateDominator(2));
+  EXPECT_EQ(2u, tree.immediateDominator(3));
+  EXPECT_TRUE(tree.dominates(1, 3));
+  EXPECT_FALSE(tree.dominates(2, 1));
+}
+
+TEST(DominatorTree, Irreducible) {
+  const DominatorTree tree =
+      Graph(3).edge(0, 1).edge(0, 2).edge(1, 2).edge(2, 1).tree();
+  EXPECT_EQ(0u, tree.immediateDominator(1));
+  EXPECT_EQ(0u, tree.immediateDominator(2));
+  EXPECT_FALSE(tree.dominates(1, 2));
+  EXPECT_FALSE(tree.dominates(2, 1));
+}
+
+TEST(DominatorTree, Unreachable) {
+  const DominatorTree tree = Graph(3).edge(0, 1).edge(2, 1).tree();
+  EXPECT_TRUE(tree.isReachable(1));
+  EXPECT_FALSE(tree.isReachable(2));
+  EXPECT_EQ(0u, tree.immediateDominator(1));
+  EXPECT_FALSE(tree.dominates(2, 1));
+  EXPECT_FALSE(tree.dominates(2, 2));
+}
+
+TEST(DominatorTree, MatchesNaiveDominatorsOnRandomGraphs) {
+  srand(42);
+  for (int trial = 0; trial < 200; ++trial) {
+    const uint32_t n = 1 + rand() % 24;
+    Graph graph(n);
+    const int num_edges = rand() % (3 * n);
+    for (int e = 0; e < num_edges; ++e) graph.edge(rand() % n, rand() % n);
+    const DominatorTree tree = graph.tree();
+    const vector<vector<bool>> dom = graph.naiveDominators();
+    for (uint32_t a = 0; a < n; ++a) {
+      for (uint32_t b = 0; b < n; ++b) {
+        ASSERT_EQ(dom[a][b], tree.dominates(a, b))
+            << "trial " << trial << " a " << a << " b " << b;
+      }
+    }
+  }
+}
+
+// The following graphs have enough blocks that quadratic time or recursion
+// per block would show.
+const uint32_t kManyBlocks = 200000;
+
+TEST(DominatorTree, DeepChain) {
+  Graph graph(kManyBlocks);
+  for (uint32_t b = 0; b + 1 < kManyBlocks; ++b) graph.edge(b, b + 1);
+  const DominatorTree tree = graph.tree();
+  for (uint32_t b = 1; b < kManyBlocks; ++b) {
+    ASSERT_EQ(b - 1, tree.immediateDominator(b));
+  }
+  EXPECT_TRUE(tree.dominates(0, kManyBlocks - 1));
+  EXPECT_FALSE(tree.dominates(kManyBlocks - 1, 0));
+}
+
+TEST(DominatorTree, DeeplyNestedLoops) {
+  // Loop headers 0 to n-1 are nested, and block n+i is the exit of the loop
+  // headed by block n-1-i, which branches back to the enclosing header.
+  const uint32_t n = kManyBlocks / 2;
+  Graph graph(2 * n + 1);
+  for (uint32_t h = 0; h + 1 < n; ++h) graph.edge(h, h + 1);
+  graph.edge(n - 1, n);
+  for (uint32_t i = 0; i < n; ++i) {
+    const uint32_t header = n - 1 - i;
+    graph.edge(n + i, header).edge(n + i, n + i + 1);
+  }
+  const DominatorTree tree = graph.tree();
+  for (uint32_t h = 1; h < n; ++h) {
+    ASSERT_EQ(h - 1, tree.immediateDominator(h));
+  }
+  EXPECT_EQ(n - 1, tree.immediateDominator(n));
+  EXPECT_TRUE(tree.dominates(n, 2 * n));
+}
+
+TEST(DominatorTree, WideSwitch) {
+  const uint32_t merge = kManyBlocks - 1;
+  Graph graph(kManyBlocks);
+  for (uint32_t b = 1; b < merge; ++b) graph.edge(0, b).edge(b, merge);
+  const DominatorTree tree = graph.tree();
+  EXPECT_EQ(0u, tree.immediateDominator(merge));
+  EXPECT_EQ(0u, tree.immediateDominator(merge / 2));
+  EXPECT_FALSE(tree.dominates(1, merge));
+}
+
+}  // anonymous namespace
@@ -206,7 +206,7 @@ TEST_P(ValidateLayout, Layout) {
   }
 }
 
-TEST_F(ValidateLayout, DISABLED_MemoryModelMissing) {
+TEST_F(ValidateLayout, MemoryModelMissing) {
   string str = R"(
     OpCapability Matrix
     OpExtension "TestExtension"
@@ -217,8 +217,47 @@ TEST_F(ValidateLayout, DISABLED_MemoryModelMissing) {
 
   CompileSuccessfully(str);
   ASSERT_EQ(SPV_ERROR_INVALID_LAYOUT, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("OpMemoryModel"));
+}
+
+TEST_F(ValidateLayout, FunctionDeclarationsBeforeDefinitionsGood) {
+  string str = R"(
+           OpCapability Shader
+           OpMemoryModel Logical GLSL450
+%void    = OpTypeVoid
+%voidf   = OpTypeFunction %void
+%decl    = OpFunction %void None %voidf
+           OpFunctionEnd
+%def     = OpFunction %void None %voidf
+%entry   = OpLabel
+           OpReturn
+           OpFunctionEnd
+)";
+
+  CompileSuccessfully(str);
+  ASSERT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(ValidateLayout, FunctionDeclarationAfterDefinitionBad) {
+  string str = R"(
+           OpCapability Shader
+           OpMemoryModel Logical GLSL450
+%void    = OpTypeVoid
+%voidf   = OpTypeFunction %void
+%def     = OpFunction %void None %voidf
+%entry   = OpLabel
+           OpReturn
+           OpFunctionEnd
+%decl    = OpFunction %void None %voidf
+           OpFunctionEnd
+)";
+
+  CompileSuccessfully(str);
+  ASSERT_EQ(SPV_ERROR_INVALID_LAYOUT, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("Function declarations must appear before function "
+                        "definitions."));
 }
 
 // TODO(umar): Test optional instructions
-// TODO(umar): Test logical layout of functions
 }
@@ -29,12 +29,14 @@
 #include "UnitSPIRV.h"
 #include "ValidateFixtures.h"
 #include "gmock/gmock.h"
+#include "source/spirv_constant.h"
 
 #include <sstream>
 #include <string>
 #include <utility>
 
 using ::testing::HasSubstr;
+using ::testing::Not;
 
 using std::string;
 using std::pair;
@@ -130,6 +132,28 @@ TEST_F(Validate, ForwardNameMissingTargetBad) {
   EXPECT_THAT(getDiagnosticString(), HasSubstr("main"));
 }
 
+// Forward references to %c, %a and %b, in that order, none of which is ever
+// defined.
+const char kUnresolvedForwardNames[] = R"(
+     OpMemoryModel Logical GLSL450
+     OpName %c "c"
+     OpName %a "a"
+     OpName %b "b"
+)";
+
+TEST_F(Validate, ForwardNamesMissingTargetsAreListedInOrder) {
+  CompileSuccessfully(kUnresolvedForwardNames);
+  ASSERT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("1[c] 2[a] 3[b]"));
+}
+
+TEST_F(Validate, ForwardNamesMissingTargetsWithImplausibleBound) {
+  CompileSuccessfully(kUnresolvedForwardNames);
+  binary_->code[SPV_INDEX_BOUND] = 0xffffffff;
+  ASSERT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("1[c] 2[a] 3[b]"));
+}
+
 TEST_F(Validate, ForwardMemberNameGood) {
   char str[] = R"(
            OpMemoryModel Logical GLSL450
@@ -157,6 +181,32 @@ TEST_F(Validate, ForwardMemberNameMissingTargetBad) {
   EXPECT_THAT(getDiagnosticString(), HasSubstr("size"));
 }
 
+// A forward reference to a struct with a name and a member name, which is
+// never defined.
+const char kUnresolvedNamedStruct[] = R"(
+     OpMemoryModel Logical GLSL450
+     OpName %struct "my_struct"
+     OpMemberName %struct 0 "value"
+)";
+
+TEST_F(Validate, ForwardMemberNameDoesNotReplaceName) {
+  CompileSuccessfully(kUnresolvedNamedStruct);
+  ASSERT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("1[my_struct]"));
+  EXPECT_THAT(getDiagnosticString(), Not(HasSubstr("value")));
+}
+
+TEST_F(Validate, ForwardNameInOppositeEndianModule) {
+  CompileSuccessfully(kUnresolvedNamedStruct);
+  for (size_t i = 0; i < binary_->wordCount; ++i) {
+    const uint32_t word = binary_->code[i];
+    binary_->code[i] = (word >> 24) | ((word >> 8) & 0xff00) |
+                       ((word << 8) & 0xff0000) | (word << 24);
+  }
+  ASSERT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("1[my_struct]"));
+}
+
 TEST_F(Validate, ForwardDecorateGood) {
   char str[] = R"(
            OpMemoryModel Logical GLSL450
@@ -997,5 +1047,118 @@ TEST_F(Validate, PhiMissingLabelBad) {
   EXPECT_THAT(getDiagnosticString(), HasSubstr("missing"));
 }
 
+// The body of a function with an if-then-else, in which %then defines %x.
+const string kNamedBranches = R"(
+OpName %x "x"
+OpName %then "then"
+OpName %else "else"
+OpName %merge "merge"
+)";
+
+const string kBranches = R"(
+%zero      = OpConstant %intt 0
+%one       = OpConstant %intt 1
+%func      = OpFunction %voidt None %vfunct
+%entry     = OpLabel
+%cond      = OpSLessThan %boolt %zero %one
+             OpSelectionMerge %merge None
+             OpBranchConditional %cond %then %else
+%then      = OpLabel
+%x         = OpIAdd %intt %one %one
+             OpBranch %merge
+)";
+
+TEST_F(Validate, DominanceUseInSameBranchGood) {
+  string str = kHeader + kBasicTypes + kBranches + R"(
+%else      = OpLabel
+             OpBranch %merge
+%merge     = OpLabel
+             OpReturn
+             OpFunctionEnd
+)";
+
+  CompileSuccessfully(str);
+  ASSERT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(Validate, DominanceUseInOtherBranchBad) {
+  string str = kHeader + kNamedBranches + kBasicTypes + kBranches + R"(
+%else      = OpLabel
+%y         = OpIAdd %intt %x %one
+             OpBranch %merge
+%merge     = OpLabel
+             OpReturn
+             OpFunctionEnd
+)";
+
+  CompileSuccessfully(str);
+  ASSERT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("1[x] defined in block 2[then] does not dominate its "
+                        "use in block 3[else]"));
+}
+
+TEST_F(Validate, DominanceUseAfterMergeBad) {
+  string str = kHeader + kNamedBranches + kBasicTypes + kBranches + R"(
+%else      = OpLabel
+             OpBranch %merge
+%merge     = OpLabel
+%y         = OpIAdd %intt %x %one
+             OpReturn
+             OpFunctionEnd
+)";
+
+  CompileSuccessfully(str);
+  ASSERT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("does not dominate its use in block 4[merge]"));
+}
+
+TEST_F(Validate, DominancePhiFromDefiningBranchGood) {
+  string str = kHeader + kBasicTypes + kBranches + R"(
+%else      = OpLabel
+             OpBranch %merge
+%merge     = OpLabel
+%y         = OpPhi %intt %x %then %zero %else
+             OpReturn
+             OpFunctionEnd
+)";
+
+  CompileSuccessfully(str);
+  ASSERT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(Validate, DominancePhiFromOtherBranchBad) {
+  string str = kHeader + kNamedBranches + kBasicTypes + kBranches + R"(
+%else      = OpLabel
+             OpBranch %merge
+%merge     = OpLabel
+%y         = OpPhi %intt %zero %then %x %else
+             OpReturn
+             OpFunctionEnd
+)";
+
+  CompileSuccessfully(str);
+  ASSERT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("does not dominate its use in block 3[else]"));
+}
+
+TEST_F(Validate, DominanceUseInUnreachableBlockGood) {
+  string str = kHeader + kBasicTypes + kBranches + R"(
+%else      = OpLabel
+             OpBranch %merge
+%dead      = OpLabel
+%y         = OpIAdd %intt %x %one
+             OpBranch %merge
+%merge     = OpLabel
+             OpReturn
+             OpFunctionEnd
+)";
+
+  CompileSuccessfully(str);
+  ASSERT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
 // TODO(umar): OpGroupMemberDecorate
 }
@@ -26,6 +26,15 @@
 
 #include "UnitSPIRV.h"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "source/spirv_constant.h"
+#include "source/table.h"
+#include "source/validate.h"
+#include "source/validate_types.h"
+
 // NOTE: The tests in this file are ONLY testing ID usage, there for the input
 // SPIR-V does not follow the logical layout rules from the spec in all cases in
 // order to makes the tests smaller. Validation of the whole module is handled
@@ -60,6 +69,186 @@ class ValidateID : public ::testing::Test {
   ASSERT_EQ(expected, result);                                          \
   spvContextDestroy(context);
 
+// Assembles the text, and returns the words of the module.
+std::vector<uint32_t> Assemble(const char* text) {
+  spv_context context = spvContextCreate();
+  spv_binary binary = nullptr;
+  spv_diagnostic diagnostic = nullptr;
+  EXPECT_EQ(SPV_SUCCESS, spvTextToBinary(context, text, strlen(text), &binary,
+                                         &diagnostic));
+  std::vector<uint32_t> words(binary->code, binary->code + binary->wordCount);
+  spvBinaryDestroy(binary);
+  spvContextDestroy(context);
+  return words;
+}
+
+// Returns the words with their bytes in the opposite order.
+std::vector<uint32_t> SwapBytes(std::vector<uint32_t> words) {
+  for (auto& word : words) {
+    word = (word >> 24) | ((word >> 8) & 0xff00) | ((word << 8) & 0xff0000) |
+           (word << 24);
+  }
+  return words;
+}
+
+// Validates the module with SPV_VALIDATE_ID_BIT, and returns the result.
+// Saves the diagnostic message, if any, in *message.
+spv_result_t ValidateIDs(const std::vector<uint32_t>& words,
+                         std::string* message) {
+  spv_context context = spvContextCreate();
+  spv_diagnostic diagnostic = nullptr;
+  spv_const_binary_t module = {words.data(), words.size()};
+  const spv_result_t result =
+      spvValidate(context, &module, SPV_VALIDATE_ID_BIT, &diagnostic);
+  message->clear();
+  if (diagnostic) *message = diagnostic->error;
+  spvDiagnosticDestroy(diagnostic);
+  spvContextDestroy(context);
+  return result;
+}
+
+// Records the instruction in the ValidationState_t given as user_data.
+spv_result_t RecordInstruction(void* user_data,
+                               const spv_parsed_instruction_t* inst) {
+  auto state = static_cast<libspirv::ValidationState_t*>(user_data);
+  state->beginInstruction(inst);
+  state->recordInstruction(inst);
+  return SPV_SUCCESS;
+}
+
+// Runs only the ID checks of spvValidate on the module, on threadCount
+// threads, and returns the result.  Saves the diagnostic message, if any, in
+// *message, and the position of the error in *index.
+spv_result_t CheckIDsOnThreads(const std::vector<uint32_t>& words,
+                               uint32_t threadCount, std::string* message,
+                               size_t* index) {
+  spv_context context = spvContextCreate();
+  spv_diagnostic diagnostic = nullptr;
+  libspirv::ValidationState_t state(&diagnostic, SPV_VALIDATE_ID_BIT);
+  EXPECT_EQ(SPV_SUCCESS,
+            spvBinaryParse(context, &state, words.data(), words.size(),
+                           nullptr, RecordInstruction, &diagnostic));
+  const auto& instructions = state.instructions();
+  const auto& idDefs = state.idDefs();
+  const auto& idUses = state.idUses();
+  spv_position_t position = {};
+  const spv_result_t result = spvValidateIDs(
+      instructions.data(), instructions.size(), idUses.data(), idUses.size(),
+      idDefs.data(), idDefs.size(), words[SPV_INDEX_BOUND],
+      context->opcode_table, context->operand_table, context->ext_inst_table,
+      threadCount, &position, &diagnostic);
+  message->clear();
+  if (diagnostic) *message = diagnostic->error;
+  *index = position.index;
+  spvDiagnosticDestroy(diagnostic);
+  spvContextDestroy(context);
+  return result;
+}
+
+// Returns a module with the given number of functions.  The functions with
+// the given indices have the wrong result type.
+std::vector<uint32_t> AssembleFunctions(int count,
+                                        const std::vector<int>& bad) {
+  std::string text = R"(
+%void = OpTypeVoid
+%int = OpTypeInt 32 0
+%fn = OpTypeFunction %void
+)";
+  for (int i = 0; i < count; ++i) {
+    const bool isBad = std::count(bad.begin(), bad.end(), i) != 0;
+    text += "%f" + std::to_string(i) + " = OpFunction " +
+            (isBad ? "%int" : "%void") +
+            " None %fn\n%l" + std::to_string(i) +
+            " = OpLabel\nOpReturn\nOpFunctionEnd\n";
+  }
+  return Assemble(text.c_str());
+}
+
+TEST(ValidateIDThreads, ValidModuleIsValidOnAnyNumberOfThreads) {
+  const auto words = AssembleFunctions(64, {});
+  for (uint32_t threadCount : {1u, 2u, 4u, 8u, 100u}) {
+    std::string message;
+    size_t index;
+    EXPECT_EQ(SPV_SUCCESS,
+              CheckIDsOnThreads(words, threadCount, &message, &index))
+        << threadCount;
+  }
+}
+
+TEST(ValidateIDThreads, FirstErrorInModuleOrderIsReported) {
+  const auto words = AssembleFunctions(64, {40, 20, 63});
+  std::string serialMessage;
+  size_t serialIndex;
+  ASSERT_EQ(SPV_ERROR_INVALID_ID,
+            CheckIDsOnThreads(words, 1, &serialMessage, &serialIndex));
+  ASSERT_FALSE(serialMessage.empty());
+  for (int repeat = 0; repeat < 20; ++repeat) {
+    for (uint32_t threadCount : {2u, 4u, 8u}) {
+      std::string message;
+      size_t index;
+      ASSERT_EQ(SPV_ERROR_INVALID_ID,
+                CheckIDsOnThreads(words, threadCount, &message, &index));
+      EXPECT_EQ(serialMessage, message);
+      EXPECT_EQ(serialIndex, index) << threadCount;
+    }
+  }
+}
+
+TEST(ValidateIDByteOrder, OppositeEndianModuleIsValidatedTheSame) {
+  const auto good = Assemble(R"(
+     OpName %2 "name"
+%1 = OpTypeInt 32 0
+%2 = OpTypePointer UniformConstant %1
+%3 = OpVariable %2 UniformConstant)");
+  const auto bad = Assemble(R"(
+%1 = OpTypeInt 32 0
+%2 = OpTypeVector %1 4
+%3 = OpTypeMatrix %2 4
+%4 = OpTypeMatrix %3 4)");
+  std::string native_message;
+  std::string swapped_message;
+  EXPECT_EQ(SPV_SUCCESS, ValidateIDs(good, &native_message));
+  EXPECT_EQ(SPV_SUCCESS, ValidateIDs(SwapBytes(good), &swapped_message));
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateIDs(bad, &native_message));
+  EXPECT_EQ(SPV_ERROR_INVALID_ID,
+            ValidateIDs(SwapBytes(bad), &swapped_message));
+  EXPECT_FALSE(native_message.empty());
+  EXPECT_EQ(native_message, swapped_message);
+}
+
+TEST(ValidateIDBound, ResultDoesNotDependOnStatedBound) {
+  const auto good = Assemble(R"(
+     OpEntryPoint GLCompute %3 ""
+     OpExecutionMode %3 LocalSize 1 1 1
+%1 = OpTypeVoid
+%2 = OpTypeFunction %1
+%3 = OpFunction %1 None %2
+%4 = OpLabel
+     OpReturn
+     OpFunctionEnd)");
+  const auto bad = Assemble(R"(
+     OpExecutionMode %3 LocalSize 1 1 1
+%1 = OpTypeVoid
+%2 = OpTypeFunction %1
+%3 = OpFunction %1 None %2
+%4 = OpLabel
+     OpReturn
+     OpFunctionEnd)");
+  std::string expected_message;
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateIDs(bad, &expected_message));
+  // Implausibly large bounds must not change the outcome.
+  for (uint32_t bound : {5u, 1000u, 0xffffffffu}) {
+    auto words = good;
+    words[SPV_INDEX_BOUND] = bound;
+    std::string message;
+    EXPECT_EQ(SPV_SUCCESS, ValidateIDs(words, &message)) << bound;
+    words = bad;
+    words[SPV_INDEX_BOUND] = bound;
+    EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateIDs(words, &message)) << bound;
+    EXPECT_EQ(expected_message, message) << bound;
+  }
+}
+
 // TODO: OpUndef
 
 TEST_F(ValidateID, OpName) {
@@ -27,9 +27,9 @@
 #include <cstdio>
 #include <cstring>
 #include <string>
-#include <vector>
 
 #include "libspirv/libspirv.h"
+#include "tools/io.h"
 
 static void print_usage(char* argv0) {
   printf(
@@ -56,6 +56,23 @@ Options:
       argv0, argv0);
 }
 
+// The output file for spvBinaryToTextStream.
+struct FileWriter {
+  FILE* file;
+  bool failed;  // Did a write fail?
+};
+
+// Writes a chunk of disassembled text to the FileWriter in user_data.
+static spv_result_t WriteToFile(void* user_data, const char* text,
+                                size_t length) {
+  auto writer = static_cast<FileWriter*>(user_data);
+  if (fwrite(text, sizeof(char), length, writer->file) != length) {
+    writer->failed = true;
+    return SPV_REQUESTED_TERMINATION;
+  }
+  return SPV_SUCCESS;
+}
+
 int main(int argc, char** argv) {
   const char* inFile = nullptr;
   const char* outFile = nullptr;
@@ -126,24 +143,11 @@ int main(int argc, char** argv) {
   }
 
   // Read the input binary.
-  std::vector<uint32_t> contents;
-  {
-    FILE* input = stdin;
-    const bool use_file = inFile && strcmp("-", inFile);
-    if (use_file) {
-      input = fopen(inFile, "rb");
-      if (!input) {
-        auto msg =
-            std::string("error: Can't open file ") + inFile + " for reading";
-        perror(msg.c_str());
-        return 1;
-      }
-    }
-    uint32_t buf[1024];
-    while (size_t len = fread(buf, sizeof(uint32_t), 1024, input)) {
-      contents.insert(contents.end(), buf, buf + len);
-    }
-    if (use_file) fclose(input);
+  BinaryInput contents;
+  if (!contents.Read(inFile)) {
+    auto msg = std::string("error: Can't open file ") + inFile + " for reading";
+    perror(msg.c_str());
+    return 1;
   }
 
   // If printing to standard output, then spvBinaryToText should
@@ -151,40 +155,42 @@ int main(int argc, char** argv) {
   // controlled by modifying console objects synchronously while
   // outputting to the stream rather than by injecting escape codes
   // into the output stream.
-  // If the printing option is off, then save the text in memory, so
-  // it can be emitted later in this function.
+  // If the printing option is off, then stream the text to the output
+  // file as it is produced, so the whole text is never held in memory.
   const bool print_to_stdout =
       spvIsInBitfield(SPV_BINARY_TO_TEXT_OPTION_PRINT, options);
-  spv_text text;
-  spv_text* textOrNull = print_to_stdout ? nullptr : &text;
+  FILE* fp = nullptr;
+  if (!print_to_stdout) {
+    fp = fopen(outFile, "w");
+    if (!fp) {
+      fprintf(stderr, "error: Could not open file '%s'\n", outFile);
+      return 1;
+    }
+  }
+  FileWriter writer = {fp, false};
+
   spv_diagnostic diagnostic = nullptr;
   spv_context context = spvContextCreate();
   spv_result_t error =
-      spvBinaryToText(context, contents.data(), contents.size(), options,
-                      textOrNull, &diagnostic);
+      print_to_stdout
+          ? spvBinaryToText(context, contents.words(), contents.num_words(),
+                            options, nullptr, &diagnostic)
+          : spvBinaryToTextStream(context, contents.words(),
+                                  contents.num_words(), options, &writer,
+                                  WriteToFile, &diagnostic);
   spvContextDestroy(context);
+  if (fp && fclose(fp)) writer.failed = true;
+  // Don't leave a partially written output file behind.
+  if (fp && (error || writer.failed)) remove(outFile);
+  if (writer.failed) {
+    fprintf(stderr, "error: Could not write to file '%s'\n", outFile);
+    return 1;
+  }
   if (error) {
     spvDiagnosticPrint(diagnostic);
     spvDiagnosticDestroy(diagnostic);
     return error;
   }
 
-  // Output the result.
-  if (!print_to_stdout) {
-    if (FILE* fp = fopen(outFile, "w")) {
-      size_t written =
-          fwrite(text->str, sizeof(char), (size_t)text->length, fp);
-      if (text->length != written) {
-        spvTextDestroy(text);
-        fprintf(stderr, "error: Could not write to file '%s'\n", outFile);
-        return 1;
-      }
-    } else {
-      spvTextDestroy(text);
-      fprintf(stderr, "error: Could not open file '%s'\n", outFile);
-      return 1;
-    }
-  }
-
   return 0;
 }
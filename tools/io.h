@@ -0,0 +1,125 @@
+// Copyright (c) 2016 The Khronos Group Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and/or associated documentation files (the
+// "Materials"), to deal in the Materials without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Materials, and to
+// permit persons to whom the Materials are furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Materials.
+//
+// MODIFICATIONS TO THIS FILE MAY MEAN IT NO LONGER ACCURATELY REFLECTS
+// KHRONOS STANDARDS. THE UNMODIFIED, NORMATIVE VERSIONS OF KHRONOS
+// SPECIFICATIONS AND HEADER INFORMATION ARE LOCATED AT
+//    https://www.khronos.org/registry/
+//
+// THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+
+#ifndef LIBSPIRV_TOOLS_IO_H_
+#define LIBSPIRV_TOOLS_IO_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if defined(SPIRV_LINUX) || defined(SPIRV_MAC)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// The words of a SPIR-V binary module read by one of the command line tools.
+//
+// When the input is a regular file, its contents are memory mapped instead
+// of being copied, so reading a large module costs neither a second copy of
+// it nor the time to make one.  Pipes, terminals and platforms without mmap
+// are read into memory.
+class BinaryInput {
+ public:
+  BinaryInput() : mapping_(nullptr), mapping_size_(0) {}
+  ~BinaryInput() { Unmap(); }
+
+  BinaryInput(const BinaryInput&) = delete;
+  BinaryInput& operator=(const BinaryInput&) = delete;
+
+  // Reads the module from the named file, or from standard input if the
+  // filename is null or "-".  Returns false if the file can't be opened, in
+  // which case errno describes the failure.  Trailing bytes that don't make up
+  // a whole word are ignored.
+  bool Read(const char* filename) {
+    Unmap();
+    contents_.clear();
+
+    const bool use_file = filename && strcmp("-", filename);
+    FILE* input = use_file ? fopen(filename, "rb") : stdin;
+    if (!input) return false;
+    if (!Map(input)) {
+      uint32_t buf[1024];
+      while (size_t len = fread(buf, sizeof(uint32_t),
+                                sizeof(buf) / sizeof(uint32_t), input)) {
+        contents_.insert(contents_.end(), buf, buf + len);
+      }
+    }
+    if (use_file) fclose(input);
+    return true;
+  }
+
+  // Returns the words of the module.
+  const uint32_t* words() const {
+    return mapping_ ? static_cast<const uint32_t*>(mapping_)
+                    : contents_.data();
+  }
+
+  // Returns the number of words in the module.
+  size_t num_words() const {
+    return mapping_ ? mapping_size_ / sizeof(uint32_t) : contents_.size();
+  }
+
+ private:
+  // Maps the contents of the given input, if it is a regular file.  Returns
+  // true on success.  The mapping remains valid after the file is closed.
+  bool Map(FILE* input) {
+#if defined(SPIRV_LINUX) || defined(SPIRV_MAC)
+    struct stat info;
+    if (fstat(fileno(input), &info) || !S_ISREG(info.st_mode)) return false;
+    // Map only whole words.  An empty mapping is not allowed.
+    const size_t size = size_t(info.st_size) & ~(sizeof(uint32_t) - 1);
+    if (size == 0) return false;
+    void* mapping =
+        mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(input), 0);
+    if (mapping == MAP_FAILED) return false;
+    // The tools read the module front to back.
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    mapping_ = mapping;
+    mapping_size_ = size;
+    return true;
+#else
+    (void)input;
+    return false;
+#endif
+  }
+
+  // Releases the mapping, if any.
+  void Unmap() {
+#if defined(SPIRV_LINUX) || defined(SPIRV_MAC)
+    if (mapping_) munmap(mapping_, mapping_size_);
+#endif
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+  }
+
+  std::vector<uint32_t> contents_;  // Used when the input is not mapped.
+  void* mapping_;                   // The mapped input, or nullptr.
+  size_t mapping_size_;             // The size of the mapping in bytes.
+};
+
+#endif  // LIBSPIRV_TOOLS_IO_H_
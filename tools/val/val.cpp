@@ -31,27 +31,66 @@
 #include <vector>
 
 #include "libspirv/libspirv.h"
+#include "tools/io.h"
 
 void print_usage(char* argv0) {
   printf(
-      "Validate a SPIR-V binary file.\n\n"
-      "USAGE: %s [options] <filename>\n\n"
+      "Validate SPIR-V binary files.\n\n"
+      "USAGE: %s [options] <filename> [<filename> ...]\n\n"
+      "Several files are validated concurrently, and the errors in each are\n"
+      "reported after its name.\n\n"
       "        -basic                     Perform basic validation (disabled)\n"
       "        -layout                    Perform layout validation "
       "(disabled)\n"
       "        -id                        Perform id validation (default ON)\n"
+      "        -parallel                  Perform id validation, checking "
+      "functions on all cores\n"
       "        -capability <capability>   Performs OpCode validation "
       "(disabled)\n",
       argv0);
 }
 
+// Validates the files together with spvValidateBatch, and prints the errors
+// found in each.  Returns the first error, or 0 if all files are valid.
+int ValidateFiles(const std::vector<const char*>& inFiles, uint32_t options) {
+  std::vector<BinaryInput> contents(inFiles.size());
+  std::vector<spv_const_binary_t> binaries;
+  std::vector<spv_const_binary> binaryPointers;
+  binaries.reserve(inFiles.size());
+  for (size_t i = 0; i < inFiles.size(); ++i) {
+    if (!contents[i].Read(inFiles[i])) {
+      fprintf(stderr, "error: file does not exist '%s'\n", inFiles[i]);
+      return 1;
+    }
+    binaries.push_back({contents[i].words(), contents[i].num_words()});
+    binaryPointers.push_back(&binaries.back());
+  }
+
+  std::vector<spv_result_t> results(inFiles.size());
+  std::vector<spv_diagnostic> diagnostics(inFiles.size(), nullptr);
+  spv_context context = spvContextCreate();
+  spv_result_t error = spvValidateBatch(
+      context, binaryPointers.data(), binaryPointers.size(), options, 0,
+      results.data(), diagnostics.data());
+  spvContextDestroy(context);
+  for (size_t i = 0; i < inFiles.size(); ++i) {
+    if (results[i]) {
+      fprintf(stderr, "%s:\n", inFiles[i]);
+      fflush(stderr);
+      spvDiagnosticPrint(diagnostics[i]);
+    }
+    spvDiagnosticDestroy(diagnostics[i]);
+  }
+  return error;
+}
+
 int main(int argc, char** argv) {
   if (2 > argc) {
     print_usage(argv[0]);
     return 1;
   }
 
-  const char* inFile = nullptr;
+  std::vector<const char*> inFiles;
   uint32_t options = 0;
 
   for (int argi = 1; argi < argc; ++argi) {
@@ -64,39 +103,33 @@ int main(int argc, char** argv) {
         options |= SPV_VALIDATE_ID_BIT;
       } else if (!strcmp("rules", argv[argi] + 1)) {
         options |= SPV_VALIDATE_RULES_BIT;
+      } else if (!strcmp("parallel", argv[argi] + 1)) {
+        options |= SPV_VALIDATE_ID_BIT | SPV_VALIDATE_PARALLEL_BIT;
       } else {
         print_usage(argv[0]);
         return 1;
       }
     } else {
-      if (!inFile) {
-        inFile = argv[argi];
-      } else {
-        print_usage(argv[0]);
-        return 1;
-      }
+      inFiles.push_back(argv[argi]);
     }
   }
 
-  if (!inFile) {
+  if (inFiles.empty()) {
     fprintf(stderr, "error: input file is empty.\n");
     return 1;
   }
 
-  std::vector<uint32_t> contents;
-  if (FILE* fp = fopen(inFile, "rb")) {
-    uint32_t buf[1024];
-    while (size_t len = fread(buf, sizeof(uint32_t),
-                              sizeof(buf) / sizeof(uint32_t), fp)) {
-      contents.insert(contents.end(), buf, buf + len);
-    }
-    fclose(fp);
-  } else {
+  if (inFiles.size() > 1) return ValidateFiles(inFiles, options);
+
+  const char* inFile = inFiles[0];
+
+  BinaryInput contents;
+  if (!contents.Read(inFile)) {
     fprintf(stderr, "error: file does not exist '%s'\n", inFile);
     return 1;
   }
 
-  spv_const_binary_t binary = {contents.data(), contents.size()};
+  spv_const_binary_t binary = {contents.words(), contents.num_words()};
 
   spv_diagnostic diagnostic = nullptr;
   spv_context context = spvContextCreate();